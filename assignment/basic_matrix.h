@@ -0,0 +1,245 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - matrix template for other scalar types
+//
+// $NoKeywords: $ivs_project_1 $basic_matrix.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file basic_matrix.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Obecna sablona matice BasicMatrix<T>. Matrix (T = double) je jeji
+ *        specializace s uplnou sadou operaci (white_box_code.h). Obe
+ *        dedi uloziste ze stejneho predka MatrixStorage<T> (zarovnane
+ *        radky, kopie, presun, get/set), obecna sablona pridava pohledy (BasicMatrixView<T>), prvkove operace nad jadry
+ *        MatrixKernels::elementwise<T>() a soucin pres gemm v typu T.
+ *        Rozklady, resice, ridke matice a vyrazove sablony zustavaji jen
+ *        pro double. Pouziva se pro T = float (MatrixF): polovicni objem
+ *        dat znamena dvojnasobnou propustnost pameti i sirku SIMD za cenu
+ *        presnosti ~7 cislic.
+ */
+
+#pragma once
+
+#ifndef BASIC_MATRIX_H_
+#define BASIC_MATRIX_H_
+
+#include <cstring>
+#include <stdexcept>
+
+#include "white_box_code.h"
+
+/**
+ * @brief Matice s prvky typu T ulozenymi po radcich
+ * T je float, jadra (gemm, getrf, prvkova jadra, ...) jsou instancovana
+ * pouze pro float a double.
+ */
+template<class T>
+class BasicMatrix : public MatrixStorage<T>
+{
+public:
+  /**
+   * @brief BasicMatrix
+   * Kontruktor vytvori nulovou matici velikosti row x col
+   */
+  BasicMatrix(size_t row, size_t col)
+  {
+    if(row < 1 || col < 1)
+      throw std::runtime_error("Minimalni velikost matice je 1x1");
+
+    allocate(row, col);
+  }
+
+  /**
+   * @brief BasicMatrix
+   * Konstruktor vytvori matici zaokrouhlenim prvku matice (pohledu)
+   * typu double na typ T
+   *
+   * @param      view   prevadeny pohled
+   */
+  explicit BasicMatrix(const ConstMatrixView &view)
+  {
+    allocate(view.rows(), view.cols());
+
+    for(size_t r = 0; r < mRows; r++)
+    {
+      for(size_t c = 0; c < mCols; c++)
+        mData[r * mStride + c] = static_cast<T>(view.data()[r * view.stride() + c]);
+    }
+  }
+
+  /**
+   * @brief BasicMatrix
+   * Konstruktor zkopiruje pohled (napr. blok) matice stejneho typu
+   */
+  explicit BasicMatrix(const BasicMatrixView<const T> &view)
+  {
+    allocate(view.rows(), view.cols(), false);
+
+    for(size_t r = 0; r < mRows; r++)
+      memcpy(mData + r * mStride, view.data() + r * view.stride(), mCols * sizeof(T));
+  }
+
+  BasicMatrix(const BasicMatrix &other) = default;
+
+  BasicMatrix(BasicMatrix &&other) = default;
+
+  BasicMatrix &operator=(const BasicMatrix &other) = default;
+
+  BasicMatrix &operator=(BasicMatrix &&other) = default;
+
+  /**
+   * @brief      porovnani
+   *        * porovna prvky matice se stejne velkou matici (pohledem)
+   */
+  bool operator==(const BasicMatrixView<const T> &m) const
+  {
+    checkSize(m);
+
+    const MatrixKernels::BasicElementwiseKernels<T> &kernels = MatrixKernels::elementwise<T>();
+
+    for(size_t r = 0; r < mRows; r++)
+    {
+      if(!kernels.equal(mCols, mData + r * mStride, m.data() + r * m.stride()))
+        return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief      scitani
+   *        * secte matici se stejne velkou matici (pohledem)
+   */
+  BasicMatrix operator+(const BasicMatrixView<const T> &m) const
+  {
+    checkSize(m);
+
+    BasicMatrix result(mRows, mCols, false);
+    const MatrixKernels::BasicElementwiseKernels<T> &kernels = MatrixKernels::elementwise<T>();
+
+    for(size_t r = 0; r < mRows; r++)
+      kernels.add(mCols, mData + r * mStride, m.data() + r * m.stride(), result.mData + r * result.mStride);
+
+    return result;
+  }
+
+  /**
+   * @brief      skalarni nasobeni
+   */
+  BasicMatrix operator*(T value) const
+  {
+    BasicMatrix result(mRows, mCols, false);
+    const MatrixKernels::BasicElementwiseKernels<T> &kernels = MatrixKernels::elementwise<T>();
+
+    for(size_t r = 0; r < mRows; r++)
+      kernels.scale(mCols, value, mData + r * mStride, result.mData + r * result.mStride);
+
+    return result;
+  }
+
+  /**
+   * @brief      pricteni na miste
+   *        * this = this + m bez alokace (m se nesmi s matici castecne
+   *          prekryvat)
+   */
+  BasicMatrix &operator+=(const BasicMatrixView<const T> &m)
+  {
+    return axpy(1, m);
+  }
+
+  /**
+   * @brief      axpy
+   *        * this = alpha * x + this jednim pruchodem (FMA), bez alokace
+   */
+  BasicMatrix &axpy(T alpha, const BasicMatrixView<const T> &x)
+  {
+    checkSize(x);
+
+    const MatrixKernels::BasicElementwiseKernels<T> &kernels = MatrixKernels::elementwise<T>();
+
+    for(size_t r = 0; r < mRows; r++)
+      kernels.fma(mCols, alpha, x.data() + r * x.stride(), mData + r * mStride, mData + r * mStride);
+
+    return *this;
+  }
+
+  /**
+   * @brief      nasobeni
+   *        * vynasobi matici matici (pohledem) blokovym gemm v typu T,
+   *          paralelne
+   *
+   * @return     vysledna matice po vynasobeni matic
+   */
+  BasicMatrix operator*(const BasicMatrixView<const T> &m) const
+  {
+    if(mCols != m.rows())
+      throw std::runtime_error("Prvni matice musi stejny pocet sloupcu jako druha radku.");
+
+    BasicMatrix result(mRows, m.cols(), false);
+
+    MatrixKernels::gemmParallel(nullptr, mRows, m.cols(), mCols, 1.0, mData, mStride,
+                                m.data(), m.stride(), 0.0, result.mData, result.mStride);
+
+    return result;
+  }
+
+  /**
+   * @brief      block
+   *        * pohled na blok rows x cols zacinajici na pozici row, col,
+   *          nic nekopiruje (viz matrix_view.h)
+   */
+  BasicMatrixView<T> block(size_t row, size_t col, size_t rows, size_t cols)
+  {
+    return BasicMatrixView<T>(*this).block(row, col, rows, cols);
+  }
+
+  BasicMatrixView<const T> block(size_t row, size_t col, size_t rows, size_t cols) const
+  {
+    return BasicMatrixView<const T>(*this).block(row, col, rows, cols);
+  }
+
+  /**
+   * @brief      pohled na jeden radek matice
+   */
+  BasicMatrixView<T> row(size_t row) { return block(row, 0, 1, mCols); }
+  BasicMatrixView<const T> row(size_t row) const { return block(row, 0, 1, mCols); }
+
+  /**
+   * @brief      pohled na jeden sloupec matice
+   */
+  BasicMatrixView<T> col(size_t col) { return block(0, col, mRows, 1); }
+  BasicMatrixView<const T> col(size_t col) const { return block(0, col, mRows, 1); }
+
+protected:
+  using MatrixStorage<T>::mData;
+  using MatrixStorage<T>::mRows;
+  using MatrixStorage<T>::mCols;
+  using MatrixStorage<T>::mStride;
+  using MatrixStorage<T>::allocate;
+  using MatrixStorage<T>::checkEqualSize;
+
+  /**
+   * @brief BasicMatrix
+   * Matice bez nulovani prvku pro vysledky, ktere se cele prepisi
+   */
+  BasicMatrix(size_t row, size_t col, bool zeroFill)
+  {
+    allocate(row, col, zeroFill);
+  }
+
+  /**
+   * @brief      vyhodi std::runtime_error, pokud m nema stejnou velikost
+   */
+  void checkSize(const BasicMatrixView<const T> &m) const
+  {
+    if(!checkEqualSize(m.rows(), m.cols()))
+      throw std::runtime_error("Matice musi mit stejnou velikost.");
+  }
+};
+
+#endif /* BASIC_MATRIX_H_ */
+
+/*** Konec souboru basic_matrix.h ***/
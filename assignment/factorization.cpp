@@ -0,0 +1,210 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - reusable matrix factorization
+//
+// $NoKeywords: $ivs_project_1 $factorization.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file factorization.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Definice metod znovupouzitelneho rozkladu matice.
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "factorization.h"
+
+/**
+ * Prah pro rozpoznani nuloveho pivotu, n * epsilon * max|a_ij|
+ */
+static double singularTolerance(ConstMatrixView a)
+{
+    double maxAbs = 0;
+
+    for(size_t r = 0; r < a.rows(); r++)
+    {
+        for(size_t c = 0; c < a.cols(); c++)
+            maxAbs = std::fmax(maxAbs, std::fabs(a.data()[r * a.stride() + c]));
+    }
+
+    return maxAbs * a.rows() * std::numeric_limits<double>::epsilon();
+}
+
+/**
+ * Symetrie se overuje presne, symetricky sestavene matice (kovariance,
+ * normalni rovnice) ji splnuji bez zaokrouhleni
+ */
+static bool isSymmetric(ConstMatrixView a)
+{
+    for(size_t r = 0; r < a.rows(); r++)
+    {
+        for(size_t c = 0; c < r; c++)
+        {
+            if(a.data()[r * a.stride() + c] != a.data()[c * a.stride() + r])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+Factorization::Factorization(ConstMatrixView a, SolveMethod method): mMethod(SOLVE_CHOLESKY), mFactors(a)
+{
+    if(method == SOLVE_QR)
+    {
+        factorQR(a);
+        return;
+    }
+
+    if(a.rows() != a.cols())
+        throw std::runtime_error("Matice musi byt ctvercova.");
+
+    if(method == SOLVE_LU || method == SOLVE_MIXED || (method == SOLVE_AUTO && !isSymmetric(a)))
+    {
+        factorLU(a);
+        return;
+    }
+
+    if(MatrixKernels::potrf(size(), mFactors.data(), mFactors.stride()))
+        return;
+
+    if(method == SOLVE_CHOLESKY)
+        throw std::runtime_error("Matice neni pozitivne definitni.");
+
+    // Rozklad prepsal dolni trojuhelnik, LU zacina znovu z puvodni matice
+    MatrixView(mFactors).assign(a);
+    factorLU(a);
+}
+
+void Factorization::factorLU(ConstMatrixView a)
+{
+    mMethod = SOLVE_LU;
+    mPivots.resize(size());
+
+    if(!MatrixKernels::getrf(size(), mFactors.data(), mFactors.stride(), mPivots.data(),
+                             singularTolerance(a)))
+        throw std::runtime_error("Matice je singularni.");
+}
+
+void Factorization::factorQR(ConstMatrixView a)
+{
+    if(a.rows() < a.cols())
+        throw std::runtime_error("Matice musi mit alespon tolik radku jako sloupcu.");
+
+    mMethod = SOLVE_QR;
+    mTau.resize(unknowns());
+    mT.resize(MatrixKernels::QR_NB * unknowns());
+
+    MatrixKernels::geqrf(size(), unknowns(), mFactors.data(), mFactors.stride(), mTau.data(), mT.data());
+
+    double tolerance = singularTolerance(a);
+
+    for(size_t k = 0; k < unknowns(); k++)
+    {
+        if(std::fabs(mFactors.data()[k * mFactors.stride() + k]) <= tolerance)
+            throw std::runtime_error("Matice nema plnou hodnost.");
+    }
+}
+
+std::vector<double> Factorization::solve(const std::vector<double> &b) const
+{
+    return solve(std::vector<double>(b));
+}
+
+std::vector<double> Factorization::solve(std::vector<double> &&b) const
+{
+    if(b.size() != size())
+        throw std::runtime_error("Pocet prvku prave strany rovnice musi odpovidat poctu radku matice.");
+
+    if(mMethod == SOLVE_QR)
+    {
+        solveInPlace(MatrixView(b.data(), b.size(), 1, 1));
+        b.resize(unknowns());
+    }
+    else if(mMethod == SOLVE_CHOLESKY)
+    {
+        MatrixKernels::potrs(size(), mFactors.data(), mFactors.stride(), b.data());
+    }
+    else
+    {
+        MatrixKernels::getrs(size(), mFactors.data(), mFactors.stride(), mPivots.data(), b.data());
+    }
+
+    return std::move(b);
+}
+
+Matrix Factorization::solve(ConstMatrixView b) const
+{
+    Matrix x(b);
+
+    solveInPlace(x);
+
+    if(mMethod == SOLVE_QR && unknowns() < size())
+        return Matrix(x.block(0, 0, unknowns(), x.cols()));
+
+    return x;
+}
+
+void Factorization::solveInPlace(MatrixView b) const
+{
+    if(b.rows() != size())
+        throw std::runtime_error("Pocet prvku prave strany rovnice musi odpovidat poctu radku matice.");
+
+    if(mMethod == SOLVE_QR)
+    {
+        MatrixKernels::ormqr(size(), unknowns(), b.cols(), mFactors.data(), mFactors.stride(),
+                             mT.data(), b.data(), b.stride());
+        MatrixKernels::trsmUpper(unknowns(), b.cols(), mFactors.data(), mFactors.stride(),
+                                 b.data(), b.stride());
+    }
+    else if(mMethod == SOLVE_CHOLESKY)
+    {
+        MatrixKernels::potrsBatch(nullptr, size(), b.cols(), mFactors.data(), mFactors.stride(),
+                                  b.data(), b.stride());
+    }
+    else
+    {
+        MatrixKernels::getrsBatch(nullptr, size(), b.cols(), mFactors.data(), mFactors.stride(),
+                                  mPivots.data(), b.data(), b.stride());
+    }
+}
+
+double Factorization::determinant() const
+{
+    if(size() != unknowns())
+        throw std::runtime_error("Matice musi byt ctvercova.");
+
+    double det = 1;
+
+    for(size_t k = 0; k < size(); k++)
+    {
+        double diag = mFactors.data()[k * mFactors.stride() + k];
+
+        if(mMethod == SOLVE_CHOLESKY)
+        {
+            det *= diag * diag;
+        }
+        else if(mMethod == SOLVE_QR)
+        {
+            // Kazdy netrivialni Householderuv reflektor ma determinant -1
+            det *= mTau[k] != 0 ? -diag : diag;
+        }
+        else
+        {
+            det *= diag;
+
+            if(mPivots[k] != k)
+                det = -det;
+        }
+    }
+
+    return det;
+}
+
+/*** Konec souboru factorization.cpp ***/
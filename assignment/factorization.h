@@ -0,0 +1,141 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - reusable matrix factorization
+//
+// $NoKeywords: $ivs_project_1 $factorization.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file factorization.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Rozklad matice spocitany jednou a pouzity pro libovolny pocet
+ *        pravych stran. Rozklad stoji O(n^3), kazde dalsi reseni uz jen
+ *        O(n^2) na jednu pravou stranu.
+ */
+
+#pragma once
+
+#ifndef FACTORIZATION_H_
+#define FACTORIZATION_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "white_box_code.h"
+
+/**
+ * @brief Rozklad matice pro opakovane reseni soustav A x = b
+ * Objekt si drzi vlastni kopii rozkladu, puvodni matice muze zaniknout.
+ * Rozklad SOLVE_QR pripousti i matice s vice radky nez sloupci, reseni je
+ * pak resenim ulohy nejmensich ctvercu.
+ */
+class Factorization
+{
+public:
+  /**
+   * @brief Factorization
+   * Konstruktor spocita rozklad matice a, pro singularni nebo
+   * nectvercovou matici (u QR pro matici s mene radky nez sloupci nebo
+   * bez plne hodnosti) vyhodi std::runtime_error
+   *
+   * @param      a       rozkladana matice
+   * @param      method  druh rozkladu, SOLVE_CHOLESKY vyhodi
+   *                     std::runtime_error pro matici, ktera neni
+   *                     pozitivne definitni, SOLVE_MIXED se
+   *                     chova jako SOLVE_LU (rozklad se uklada v double)
+   */
+  explicit Factorization(ConstMatrixView a, SolveMethod method = SOLVE_LU);
+
+  /**
+   * @brief      skutecne pouzity rozklad (SOLVE_LU, SOLVE_CHOLESKY nebo
+   *             SOLVE_QR)
+   */
+  SolveMethod method() const { return mMethod; }
+
+  /**
+   * @brief      pocet rovnic (radku rozlozene matice, delka prave strany)
+   */
+  size_t size() const { return mFactors.rows(); }
+
+  /**
+   * @brief      pocet neznamych (sloupcu rozlozene matice, delka reseni)
+   */
+  size_t unknowns() const { return mFactors.cols(); }
+
+  /**
+   * @brief      solve
+   *        * vyresi A x = b
+   *
+   * @param      b prava strana rovnice
+   *
+   * @return     pole vysledku x1, x2, ...
+   */
+  std::vector<double> solve(const std::vector<double> &b) const;
+
+  /**
+   * @brief      solve
+   *        * docasna prava strana je prepsana resenim a vracena
+   */
+  std::vector<double> solve(std::vector<double> &&b) const;
+
+  /**
+   * @brief      solve
+   *        * vyresi A X = B pro vsechny sloupce B najednou, blokove
+   *          trojuhelnikove soustavy (level 3) rozdelene mezi vlakna
+   *
+   * @param      b      prave strany ve sloupcich (size() x k)
+   *
+   * @return     reseni ve sloupcich
+   */
+  Matrix solve(ConstMatrixView b) const;
+
+  /**
+   * @brief      solveInPlace
+   *        * jako solve(), reseni prepise prave strany v b (u QR prvnich
+   *          unknowns() radku b)
+   */
+  void solveInPlace(MatrixView b) const;
+
+  /**
+   * @brief      determinant rozlozene (ctvercove) matice v O(n)
+   */
+  double determinant() const;
+
+protected:
+  SolveMethod mMethod;
+
+  /**
+   * Faktory ulozene na miste puvodni matice (L a U, L pro Choleskeho
+   * rozklad, R a Householderovy vektory pro QR)
+   */
+  Matrix mFactors;
+
+  std::vector<size_t> mPivots;
+
+  /**
+   * Koeficienty Householderovych reflektoru rozkladu QR
+   */
+  std::vector<double> mTau;
+
+  /**
+   * Trojuhelnikove faktory T bloku reflektoru (viz MatrixKernels::geqrf)
+   */
+  std::vector<double> mT;
+
+  /**
+   * @brief      LU rozklad, pro singularni matici vyhodi std::runtime_error
+   */
+  void factorLU(ConstMatrixView a);
+
+  /**
+   * @brief      QR rozklad, pro matici bez plne hodnosti vyhodi
+   *             std::runtime_error
+   */
+  void factorQR(ConstMatrixView a);
+};
+
+#endif /* FACTORIZATION_H_ */
+
+/*** Konec souboru factorization.h ***/
@@ -0,0 +1,272 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - compile-time sized matrix
+//
+// $NoKeywords: $ivs_project_1 $fixed_matrix.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file fixed_matrix.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Matice s velikosti danou pri prekladu (typicky 2x2 az 4x4).
+ *        Prvky lezi primo v objektu (na zasobniku), vsechny operace jsou
+ *        constexpr a rozvinute pri prekladu, bez alokaci a bez kontrol
+ *        velikosti za behu.
+ */
+
+#pragma once
+
+#ifndef FIXED_MATRIX_H_
+#define FIXED_MATRIX_H_
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "white_box_code.h"
+
+namespace FixedMatrixDetail
+{
+  /**
+   * Posloupnost indexu 0..N-1 pro rozvinuti konstrukce vysledku (C++11
+   * nema std::index_sequence)
+   */
+  template<size_t... I> struct IndexSeq {};
+
+  template<size_t N, size_t... I>
+  struct MakeIndexSeq : MakeIndexSeq<N - 1, N - 1, I...> {};
+
+  template<size_t... I>
+  struct MakeIndexSeq<0, I...> { typedef IndexSeq<I...> type; };
+}
+
+/**
+ * @brief Matice pevne velikosti R x C
+ * Agregat s prvky ulozenymi po radcich, lze ji tedy inicializovat primo
+ * seznamem hodnot: FixedMatrix<2, 2> m = {{1, 2, 3, 4}};
+ */
+template<size_t R, size_t C>
+struct FixedMatrix
+{
+  static_assert(R > 0 && C > 0, "Minimalni velikost matice je 1x1");
+
+  /**
+   * Prvky matice ulozene po radcich
+   */
+  double mData[R * C];
+
+  constexpr size_t rows() const { return R; }
+
+  constexpr size_t cols() const { return C; }
+
+  /**
+   * @brief      hodnota prvku na pozici row, col (bez kontroly indexu)
+   */
+  constexpr double operator()(size_t row, size_t col) const { return mData[row * C + col]; }
+
+  double &operator()(size_t row, size_t col) { return mData[row * C + col]; }
+
+  /**
+   * @brief      transpose
+   *
+   * @return     transponovana matice
+   */
+  constexpr FixedMatrix<C, R> transpose() const
+  {
+    return transposeImpl(typename FixedMatrixDetail::MakeIndexSeq<R * C>::type());
+  }
+
+  /**
+   * @brief      determinant
+   *        * rady 1 az 3 primo z definice, rad 4 rozvojem podle radku.
+   *          Rozvoj ma slozitost O(R!), vetsi matice proto resi Matrix
+   *          (LU rozklad).
+   *
+   * @return     determinant matice
+   */
+  constexpr double determinant() const
+  {
+    static_assert(R == C, "Matice musi byt ctvercova.");
+    static_assert(R <= 4, "Determinant pevne matice je jen do radu 4, vetsi matice resi Matrix.");
+    return detImpl(std::integral_constant<size_t, (R < 4 ? R : 0)>());
+  }
+
+  /**
+   * @brief      inverse
+   *        * inverze pomoci adjungovane matice (do radu 4), pro singularni
+   *          matici vyhodi std::runtime_error
+   *
+   * @return     invertovana matice
+   */
+  constexpr FixedMatrix<R, C> inverse() const
+  {
+    static_assert(R == C, "Matice musi byt ctvercova.");
+    static_assert(R <= 4, "Inverze pevne matice je jen do radu 4, vetsi matice resi Matrix.");
+    return inverseImpl(determinant(), typename FixedMatrixDetail::MakeIndexSeq<R * C>::type());
+  }
+
+  /**
+   * @brief      fromMatrix
+   *        * prevede dynamickou matici na matici pevne velikosti
+   *
+   * @param      m     matice velikosti R x C
+   *
+   * @return     kopie matice m
+   */
+  static FixedMatrix<R, C> fromMatrix(const Matrix &m)
+  {
+    if(m.rows() != R || m.cols() != C)
+      throw std::runtime_error("Matice musi mit stejnou velikost.");
+
+    FixedMatrix<R, C> result;
+
+    for(size_t r = 0; r < R; r++)
+    {
+      for(size_t c = 0; c < C; c++)
+        result.mData[r * C + c] = m.data()[r * m.stride() + c];
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief      prevod na dynamickou matici
+   */
+  explicit operator Matrix() const
+  {
+    Matrix result(R, C);
+
+    for(size_t r = 0; r < R; r++)
+    {
+      for(size_t c = 0; c < C; c++)
+        result.data()[r * result.stride() + c] = mData[r * C + c];
+    }
+
+    return result;
+  }
+
+  // Pomocne funkce, jednotlive kroky jsou kvuli C++11 constexpr rekurzivni
+
+  template<size_t... I>
+  constexpr FixedMatrix<C, R> transposeImpl(FixedMatrixDetail::IndexSeq<I...>) const
+  {
+    return FixedMatrix<C, R>{{ mData[(I % R) * C + I / R]... }};
+  }
+
+  constexpr double detImpl(std::integral_constant<size_t, 1>) const
+  {
+    return mData[0];
+  }
+
+  constexpr double detImpl(std::integral_constant<size_t, 2>) const
+  {
+    return mData[0] * mData[3] - mData[2] * mData[1];
+  }
+
+  constexpr double detImpl(std::integral_constant<size_t, 3>) const
+  {
+    return mData[0] * mData[4] * mData[8] +
+           mData[1] * mData[5] * mData[6] +
+           mData[2] * mData[3] * mData[7] -
+           mData[6] * mData[4] * mData[2] -
+           mData[7] * mData[5] * mData[0] -
+           mData[8] * mData[1] * mData[3];
+  }
+
+  constexpr double detImpl(std::integral_constant<size_t, 0>) const
+  {
+    return minorDet(fullMask(), fullMask());
+  }
+
+  static constexpr unsigned fullMask() { return (1u << R) - 1u; }
+
+  static constexpr size_t lowestBit(unsigned mask, size_t bit)
+  {
+    return (mask >> bit) & 1u ? bit : lowestBit(mask, bit + 1);
+  }
+
+  /**
+   * Determinant podmatice tvorene radky rowMask a sloupci colMask, rozvoj
+   * podle nejnizsiho zbyvajiciho radku
+   */
+  constexpr double minorDet(unsigned rowMask, unsigned colMask) const
+  {
+    return rowMask == 0 ? 1.0 : expand(lowestBit(rowMask, 0), rowMask, colMask, 0, 1.0);
+  }
+
+  constexpr double expand(size_t row, unsigned rowMask, unsigned colMask, size_t col, double sign) const
+  {
+    return col == C ? 0.0 :
+           (colMask >> col) & 1u
+             ? sign * mData[row * C + col] * minorDet(rowMask & ~(1u << row), colMask & ~(1u << col))
+               + expand(row, rowMask, colMask, col + 1, -sign)
+             : expand(row, rowMask, colMask, col + 1, sign);
+  }
+
+  /**
+   * Prvek [i][j] inverze je algebraicky doplnek prvku [j][i] deleny
+   * determinantem
+   */
+  constexpr double inverseAt(size_t i, size_t j, double det) const
+  {
+    return ((i + j) % 2 == 0 ? 1.0 : -1.0) *
+           minorDet(fullMask() & ~(1u << j), fullMask() & ~(1u << i)) / det;
+  }
+
+  template<size_t... I>
+  constexpr FixedMatrix<R, C> inverseImpl(double det, FixedMatrixDetail::IndexSeq<I...>) const
+  {
+    return (det < 0 ? -det : det) < std::numeric_limits<double>::epsilon()
+           ? throw std::runtime_error("Matice je singularni.")
+           : FixedMatrix<R, C>{{ inverseAt(I / C, I % C, det)... }};
+  }
+};
+
+namespace FixedMatrixDetail
+{
+  template<size_t R, size_t K, size_t C>
+  constexpr double dot(const FixedMatrix<R, K> &a, const FixedMatrix<K, C> &b,
+                       size_t row, size_t col, size_t k, double acc)
+  {
+    return k == K ? acc : dot(a, b, row, col, k + 1, acc + a(row, k) * b(k, col));
+  }
+
+  template<size_t R, size_t K, size_t C, size_t... I>
+  constexpr FixedMatrix<R, C> multiply(const FixedMatrix<R, K> &a, const FixedMatrix<K, C> &b,
+                                       IndexSeq<I...>)
+  {
+    return FixedMatrix<R, C>{{ dot(a, b, I / C, I % C, 0, 0.0)... }};
+  }
+
+  template<size_t R, size_t C>
+  constexpr bool equal(const FixedMatrix<R, C> &a, const FixedMatrix<R, C> &b, size_t i)
+  {
+    return i == R * C ? true : a.mData[i] == b.mData[i] && equal(a, b, i + 1);
+  }
+}
+
+/**
+ * @brief      nasobeni matic pevne velikosti, rozmery se kontroluji pri
+ *             prekladu
+ */
+template<size_t R, size_t K, size_t C>
+constexpr FixedMatrix<R, C> operator*(const FixedMatrix<R, K> &a, const FixedMatrix<K, C> &b)
+{
+  return FixedMatrixDetail::multiply(a, b, typename FixedMatrixDetail::MakeIndexSeq<R * C>::type());
+}
+
+/**
+ * @brief      porovnani matic pevne velikosti
+ */
+template<size_t R, size_t C>
+constexpr bool operator==(const FixedMatrix<R, C> &a, const FixedMatrix<R, C> &b)
+{
+  return FixedMatrixDetail::equal(a, b, 0);
+}
+
+#endif /* FIXED_MATRIX_H_ */
+
+/*** Konec souboru fixed_matrix.h ***/
@@ -0,0 +1,463 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - iterative linear solvers
+//
+// $NoKeywords: $ivs_project_1 $iterative_solvers.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file iterative_solvers.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Implementace metod CG a GMRES a predpodminovacu Jacobi a ILU(0).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "iterative_solvers.h"
+
+namespace IterativeSolvers
+{
+  /**
+   * Nasobeni matici y = A x
+   */
+  typedef std::function<void(const double *, double *)> Apply;
+
+  /**
+   * Relativni presnost double, prah rozpadu GMRES
+   */
+  static const double EPSILON = std::numeric_limits<double>::epsilon();
+
+  /**
+   * Sestaveny predpodminovac, apply() vypocte z = M^-1 r
+   */
+  struct PreconditionerData
+  {
+    Preconditioner kind = PRECOND_NONE;
+
+    std::vector<double> invDiag;
+
+    /**
+     * Faktory ILU(0) ve formatu CSR se vzorem nenul A, L ma jednotkovou
+     * diagonalu (neulozenou), diagonala patri U
+     */
+    std::vector<size_t> pointers;
+    std::vector<size_t> indices;
+    std::vector<size_t> diagonal;
+    std::vector<double> values;
+
+    void apply(size_t n, const double *r, double *z) const
+    {
+      if(kind == PRECOND_NONE)
+      {
+        std::copy(r, r + n, z);
+      }
+      else if(kind == PRECOND_JACOBI)
+      {
+        for(size_t i = 0; i < n; i++)
+          z[i] = r[i] * invDiag[i];
+      }
+      else
+      {
+        for(size_t i = 0; i < n; i++)
+        {
+          double sum = r[i];
+
+          for(size_t p = pointers[i]; p < diagonal[i]; p++)
+            sum -= values[p] * z[indices[p]];
+
+          z[i] = sum;
+        }
+
+        for(size_t i = n; i-- > 0; )
+        {
+          double sum = z[i];
+
+          for(size_t p = diagonal[i] + 1; p < pointers[i + 1]; p++)
+            sum -= values[p] * z[indices[p]];
+
+          z[i] = sum / values[diagonal[i]];
+        }
+      }
+    }
+  };
+
+  static void jacobi(PreconditionerData &m, const std::vector<double> &diag)
+  {
+    m.invDiag.resize(diag.size());
+
+    for(size_t i = 0; i < diag.size(); i++)
+    {
+      if(diag[i] == 0)
+        throw std::runtime_error("Matice ma nulovy prvek na diagonale.");
+
+      m.invDiag[i] = 1.0 / diag[i];
+    }
+  }
+
+  static void ilu0(PreconditionerData &m, const SparseMatrix &a)
+  {
+    const SparseMatrix csr = a.convert(SparseMatrix::CSR);
+    const size_t n = csr.rows();
+    const size_t none = std::numeric_limits<size_t>::max();
+    std::vector<size_t> position(n, none);
+
+    m.pointers = csr.pointers();
+    m.indices = csr.indices();
+    m.values = csr.values();
+    m.diagonal.resize(n);
+
+    for(size_t i = 0; i < n; i++)
+    {
+      std::vector<size_t>::const_iterator begin = m.indices.begin() + m.pointers[i];
+      std::vector<size_t>::const_iterator end = m.indices.begin() + m.pointers[i + 1];
+      std::vector<size_t>::const_iterator diag = std::lower_bound(begin, end, i);
+
+      if(diag == end || *diag != i)
+        throw std::runtime_error("Matice ma nulovy prvek na diagonale.");
+
+      m.diagonal[i] = diag - m.indices.begin();
+
+      for(size_t p = m.pointers[i]; p < m.pointers[i + 1]; p++)
+        position[m.indices[p]] = p;
+
+      // Eliminace radku i radky k < i, upravuji se jen prvky ze vzoru A
+      for(size_t p = m.pointers[i]; p < m.diagonal[i]; p++)
+      {
+        size_t k = m.indices[p];
+
+        m.values[p] /= m.values[m.diagonal[k]];
+
+        for(size_t q = m.diagonal[k] + 1; q < m.pointers[k + 1]; q++)
+        {
+          if(position[m.indices[q]] != none)
+            m.values[position[m.indices[q]]] -= m.values[p] * m.values[q];
+        }
+      }
+
+      for(size_t p = m.pointers[i]; p < m.pointers[i + 1]; p++)
+        position[m.indices[p]] = none;
+
+      if(m.values[m.diagonal[i]] == 0)
+        throw std::runtime_error("Matice je singularni.");
+    }
+  }
+
+  static double dot(size_t n, const double *x, const double *y)
+  {
+    return MatrixKernels::dot(nullptr, n, x, y);
+  }
+
+  static double norm(size_t n, const double *x)
+  {
+    return std::sqrt(dot(n, x, x));
+  }
+
+  /**
+   * Skutecna relativni norma rezidua ||b - A x|| / ||b||
+   */
+  static double residual(const Apply &a, const std::vector<double> &b, const std::vector<double> &x,
+                         double normB)
+  {
+    std::vector<double> r(b.size());
+
+    a(x.data(), r.data());
+
+    for(size_t i = 0; i < r.size(); i++)
+      r[i] = b[i] - r[i];
+
+    return norm(r.size(), r.data()) / normB;
+  }
+
+  static void checkSystem(size_t rows, size_t cols, const std::vector<double> &b)
+  {
+    if(cols != b.size())
+      throw std::runtime_error("Pocet prvku prave strany rovnice musi odpovidat poctu radku matice.");
+
+    if(rows != cols)
+      throw std::runtime_error("Matice musi byt ctvercova.");
+  }
+
+  static std::vector<double> cg(const Apply &a, const PreconditionerData &m, const std::vector<double> &b,
+                                const Options &options, Stats &stats)
+  {
+    const size_t n = b.size();
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+    const double normB = norm(n, b.data());
+    std::vector<double> x(n, 0.0), r(b), z(n), p(n), q(n);
+
+    stats = Stats();
+
+    if(normB == 0)
+    {
+      stats.converged = true;
+      return x;
+    }
+
+    m.apply(n, r.data(), z.data());
+    p = z;
+
+    double rz = dot(n, r.data(), z.data());
+
+    while(norm(n, r.data()) > options.tolerance * normB && stats.iterations < options.maxIterations)
+    {
+      a(p.data(), q.data());
+
+      double pq = dot(n, p.data(), q.data());
+
+      if(pq <= 0)
+        throw std::runtime_error("Matice neni pozitivne definitni.");
+
+      double alpha = rz / pq;
+
+      kernels.fma(n, alpha, p.data(), x.data(), x.data());
+      kernels.fma(n, -alpha, q.data(), r.data(), r.data());
+
+      m.apply(n, r.data(), z.data());
+
+      double rzNext = dot(n, r.data(), z.data());
+
+      kernels.fma(n, rzNext / rz, p.data(), z.data(), p.data());
+      rz = rzNext;
+      stats.iterations++;
+    }
+
+    stats.residual = residual(a, b, x, normB);
+    stats.converged = stats.residual <= options.tolerance;
+
+    return x;
+  }
+
+  static std::vector<double> gmresRestarted(const Apply &a, const PreconditionerData &m,
+                                            const std::vector<double> &b, const Options &options,
+                                            Stats &stats)
+  {
+    const size_t n = b.size();
+    const size_t restart = std::max<size_t>(1, std::min(options.restart, n));
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+    const double normB = norm(n, b.data());
+    std::vector<double> x(n, 0.0), r(n), w(n), z(n);
+
+    // Krylovova baze po radcich, Hessenbergova matice po sloupcich
+    std::vector<double> v((restart + 1) * n);
+    std::vector<double> h(restart * (restart + 1));
+    std::vector<double> cs(restart), sn(restart), g(restart + 1), y(restart);
+
+    stats = Stats();
+
+    if(normB == 0)
+    {
+      stats.converged = true;
+      return x;
+    }
+
+    while(stats.iterations < options.maxIterations)
+    {
+      a(x.data(), r.data());
+
+      for(size_t i = 0; i < n; i++)
+        r[i] = b[i] - r[i];
+
+      double beta = norm(n, r.data());
+
+      if(beta <= options.tolerance * normB)
+        break;
+
+      kernels.scale(n, 1.0 / beta, r.data(), v.data());
+      std::fill(g.begin(), g.end(), 0.0);
+      g[0] = beta;
+
+      size_t k = 0;
+      bool breakdown = false;
+      double normH = 0;
+
+      while(k < restart && stats.iterations < options.maxIterations)
+      {
+        double *hk = h.data() + k * (restart + 1);
+
+        m.apply(n, v.data() + k * n, z.data());
+        a(z.data(), w.data());
+        stats.iterations++;
+
+        double normAz = norm(n, w.data());
+
+        // Modifikovany Gram-Schmidt
+        for(size_t i = 0; i <= k; i++)
+        {
+          hk[i] = dot(n, w.data(), v.data() + i * n);
+          kernels.fma(n, -hk[i], v.data() + i * n, w.data(), w.data());
+        }
+
+        hk[k + 1] = norm(n, w.data());
+
+        // Zbytek na urovni zaokrouhleni: baze je invariantni vuci A
+        // (stastny rozpad), dalsi smer by byl jen sum
+        if(hk[k + 1] <= EPSILON * normAz)
+        {
+          hk[k + 1] = 0;
+          breakdown = true;
+        }
+        else
+        {
+          kernels.scale(n, 1.0 / hk[k + 1], w.data(), v.data() + (k + 1) * n);
+        }
+
+        for(size_t i = 0; i <= k + 1; i++)
+          normH = std::hypot(normH, hk[i]);
+
+        // Givensovy rotace prevadi H na hornu trojuhelnikovou
+        for(size_t i = 0; i < k; i++)
+        {
+          double t = cs[i] * hk[i] + sn[i] * hk[i + 1];
+
+          hk[i + 1] = -sn[i] * hk[i] + cs[i] * hk[i + 1];
+          hk[i] = t;
+        }
+
+        double d = std::hypot(hk[k], hk[k + 1]);
+
+        // Diagonala na urovni zaokrouhleni vuci ||H||: operator je na baze
+        // singularni, sloupec se do reseni nezahrne a iterace konci
+        if(d <= EPSILON * normH)
+        {
+          breakdown = true;
+          break;
+        }
+
+        cs[k] = hk[k] / d;
+        sn[k] = hk[k + 1] / d;
+        hk[k] = d;
+        hk[k + 1] = 0;
+        g[k + 1] = -sn[k] * g[k];
+        g[k] *= cs[k];
+        k++;
+
+        if(breakdown || std::fabs(g[k]) <= options.tolerance * normB)
+          break;
+      }
+
+      // x += M^-1 (V y), kde H y = g
+      for(size_t i = k; i-- > 0; )
+      {
+        double sum = g[i];
+
+        for(size_t j = i + 1; j < k; j++)
+          sum -= h[j * (restart + 1) + i] * y[j];
+
+        y[i] = sum / h[i * (restart + 1) + i];
+      }
+
+      std::fill(w.begin(), w.end(), 0.0);
+
+      for(size_t i = 0; i < k; i++)
+        kernels.fma(n, y[i], v.data() + i * n, w.data(), w.data());
+
+      m.apply(n, w.data(), z.data());
+      kernels.add(n, x.data(), z.data(), x.data());
+
+      if(breakdown || std::fabs(g[k]) <= options.tolerance * normB)
+        break;
+    }
+
+    stats.residual = residual(a, b, x, normB);
+    stats.converged = stats.residual <= options.tolerance;
+
+    return x;
+  }
+
+  static Apply denseApply(const Matrix &a)
+  {
+    return [&a](const double *x, double *y) {
+      MatrixKernels::gemv(nullptr, MatrixKernels::NO_TRANS, a.rows(), a.cols(), 1.0,
+                          a.data(), a.stride(), x, 0.0, y);
+    };
+  }
+
+  static Apply sparseApply(const SparseMatrix &a)
+  {
+    return [&a](const double *x, double *y) {
+      a.multiply(nullptr, x, y);
+    };
+  }
+
+  static PreconditionerData precondition(const Matrix &a, Preconditioner kind)
+  {
+    PreconditionerData m;
+
+    m.kind = kind;
+
+    if(kind == PRECOND_JACOBI)
+    {
+      std::vector<double> diag(a.rows());
+
+      for(size_t i = 0; i < a.rows(); i++)
+        diag[i] = a.data()[i * a.stride() + i];
+
+      jacobi(m, diag);
+    }
+    else if(kind == PRECOND_ILU0)
+    {
+      ilu0(m, SparseMatrix(a));
+    }
+
+    return m;
+  }
+
+  static PreconditionerData precondition(const SparseMatrix &a, Preconditioner kind)
+  {
+    PreconditionerData m;
+
+    m.kind = kind;
+
+    if(kind == PRECOND_JACOBI)
+    {
+      std::vector<double> diag(a.rows());
+
+      for(size_t i = 0; i < a.rows(); i++)
+        diag[i] = a.get(i, i);
+
+      jacobi(m, diag);
+    }
+    else if(kind == PRECOND_ILU0)
+    {
+      ilu0(m, a);
+    }
+
+    return m;
+  }
+
+  std::vector<double> conjugateGradient(const Matrix &a, const std::vector<double> &b,
+                                        const Options &options, Stats &stats)
+  {
+    checkSystem(a.rows(), a.cols(), b);
+    return cg(denseApply(a), precondition(a, options.preconditioner), b, options, stats);
+  }
+
+  std::vector<double> conjugateGradient(const SparseMatrix &a, const std::vector<double> &b,
+                                        const Options &options, Stats &stats)
+  {
+    checkSystem(a.rows(), a.cols(), b);
+    return cg(sparseApply(a), precondition(a, options.preconditioner), b, options, stats);
+  }
+
+  std::vector<double> gmres(const Matrix &a, const std::vector<double> &b,
+                            const Options &options, Stats &stats)
+  {
+    checkSystem(a.rows(), a.cols(), b);
+    return gmresRestarted(denseApply(a), precondition(a, options.preconditioner), b, options, stats);
+  }
+
+  std::vector<double> gmres(const SparseMatrix &a, const std::vector<double> &b,
+                            const Options &options, Stats &stats)
+  {
+    checkSystem(a.rows(), a.cols(), b);
+    return gmresRestarted(sparseApply(a), precondition(a, options.preconditioner), b, options, stats);
+  }
+}
+
+/*** Konec souboru iterative_solvers.cpp ***/
@@ -0,0 +1,118 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - iterative linear solvers
+//
+// $NoKeywords: $ivs_project_1 $iterative_solvers.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file iterative_solvers.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Iteracni reseni soustav A x = b: metoda sdruzenych gradientu (CG)
+ *        pro symetricke pozitivne definitni matice a GMRES s restartem pro
+ *        obecne matice. Matice se pouziva pouze k nasobeni vektorem, pro
+ *        ridke matice je tedy cena iterace O(nnz).
+ */
+
+#pragma once
+
+#ifndef ITERATIVE_SOLVERS_H_
+#define ITERATIVE_SOLVERS_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "white_box_code.h"
+#include "sparse_matrix.h"
+
+namespace IterativeSolvers
+{
+  /**
+   * Predpodminovac M ~ A, metody pracuji se soustavou M^-1 A
+   */
+  enum Preconditioner
+  {
+    PRECOND_NONE,
+    PRECOND_JACOBI,   ///< diagonala A
+    PRECOND_ILU0      ///< neuplny LU rozklad bez zaplneni (vzor nenul A)
+  };
+
+  /**
+   * @brief Nastaveni iteracni metody
+   */
+  struct Options
+  {
+    /**
+     * Pozadovana relativni norma rezidua ||b - A x|| / ||b||
+     */
+    double tolerance = 1e-10;
+
+    /**
+     * Maximalni pocet iteraci (nasobeni matici)
+     */
+    size_t maxIterations = 1000;
+
+    /**
+     * Delka Krylovovy baze GMRES pred restartem
+     */
+    size_t restart = 30;
+
+    Preconditioner preconditioner = PRECOND_NONE;
+  };
+
+  /**
+   * @brief Prubeh reseni
+   */
+  struct Stats
+  {
+    size_t iterations = 0;
+
+    /**
+     * Skutecna relativni norma rezidua vraceneho reseni
+     */
+    double residual = 0;
+
+    bool converged = false;
+  };
+
+  /**
+   * @brief      conjugateGradient
+   *        * predpodminena metoda sdruzenych gradientu, pro matici, ktera
+   *          neni pozitivne definitni, vyhodi std::runtime_error
+   *
+   * @param      a        ctvercova symetricka pozitivne definitni matice
+   * @param      b        prava strana rovnice
+   * @param      options  nastaveni metody
+   * @param      stats    prubeh reseni, pri nedosazeni presnosti je
+   *                      converged == false a vraci se posledni aproximace
+   *
+   * @return     pole vysledku x1, x2, ...
+   */
+  std::vector<double> conjugateGradient(const Matrix &a, const std::vector<double> &b,
+                                        const Options &options, Stats &stats);
+  std::vector<double> conjugateGradient(const SparseMatrix &a, const std::vector<double> &b,
+                                        const Options &options, Stats &stats);
+
+  /**
+   * @brief      gmres
+   *        * GMRES(options.restart) s predpodminenim zprava, reziduum se
+   *          tedy meri pro puvodni soustavu
+   *
+   * @param      a        ctvercova regularni matice
+   * @param      b        prava strana rovnice
+   * @param      options  nastaveni metody
+   * @param      stats    prubeh reseni
+   *
+   * @return     pole vysledku x1, x2, ...
+   */
+  std::vector<double> gmres(const Matrix &a, const std::vector<double> &b,
+                            const Options &options, Stats &stats);
+  std::vector<double> gmres(const SparseMatrix &a, const std::vector<double> &b,
+                            const Options &options, Stats &stats);
+}
+
+#endif /* ITERATIVE_SOLVERS_H_ */
+
+/*** Konec souboru iterative_solvers.h ***/
@@ -0,0 +1,476 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - batches of small matrices
+//
+// $NoKeywords: $ivs_project_1 $matrix_batch.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file matrix_batch.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Definice metod davky malych matic. Jadra pocitaji kazdou matici
+ *        pevnymi vzorci bez vetveni, smycka pres souvisle ulozene matice
+ *        davky se vektorizuje (jedna draha SIMD registru = jedna matice).
+ */
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "matrix_batch.h"
+#include "thread_pool.h"
+
+using MatrixKernels::alignedAlloc;
+using MatrixKernels::alignedFree;
+
+/**
+ * Pocet matic zpracovanych spolecne (jedno zarovnane pole prvku), hranice
+ * mezi castmi davky pro ruzna vlakna lezi vzdy na hranici bloku
+ */
+static const size_t BATCH_LANES = MATRIX_ALIGN_ELEMS;
+
+/**
+ * Nejvyssi rad matic, pro ktery existuji pevne vzorce
+ */
+static const size_t BATCH_MAX_ORDER = 4;
+
+/**
+ * Minimalni pocet matic, od ktereho se davka deli mezi vlakna
+ */
+static const size_t BATCH_PARALLEL_MIN = 1 << 14;
+
+MatrixBatch::MatrixBatch(size_t row, size_t col, size_t count):
+    mData(nullptr), mRows(row), mCols(col), mCount(count), mStride(0)
+{
+    if(row < 1 || col < 1)
+        throw std::runtime_error("Minimalni velikost matice je 1x1");
+
+    const size_t maxElems = std::numeric_limits<size_t>::max() / sizeof(double);
+
+    if(count > maxElems - MATRIX_ALIGN_ELEMS)
+        throw std::length_error("Matice je prilis velka.");
+
+    mStride = (count + MATRIX_ALIGN_ELEMS - 1) / MATRIX_ALIGN_ELEMS * MATRIX_ALIGN_ELEMS;
+
+    if(mStride != 0 && row * col > maxElems / mStride)
+        throw std::length_error("Matice je prilis velka.");
+
+    mData = alignedAlloc(row * col * mStride);
+    memset(mData, 0, row * col * mStride * sizeof(double));
+}
+
+MatrixBatch::MatrixBatch(const MatrixBatch &other): MatrixBatch(other.mRows, other.mCols, other.mCount)
+{
+    memcpy(mData, other.mData, mRows * mCols * mStride * sizeof(double));
+}
+
+MatrixBatch::MatrixBatch(MatrixBatch &&other):
+    mData(other.mData), mRows(other.mRows), mCols(other.mCols), mCount(other.mCount), mStride(other.mStride)
+{
+    other.mData = nullptr;
+    other.mRows = other.mCols = other.mCount = other.mStride = 0;
+}
+
+MatrixBatch::~MatrixBatch()
+{
+    alignedFree(mData);
+}
+
+MatrixBatch &MatrixBatch::operator=(const MatrixBatch &other)
+{
+    if(this != &other)
+        *this = MatrixBatch(other);
+
+    return *this;
+}
+
+MatrixBatch &MatrixBatch::operator=(MatrixBatch &&other)
+{
+    if(this == &other)
+        return *this;
+
+    alignedFree(mData);
+
+    mData = other.mData;
+    mRows = other.mRows;
+    mCols = other.mCols;
+    mCount = other.mCount;
+    mStride = other.mStride;
+
+    other.mData = nullptr;
+    other.mRows = other.mCols = other.mCount = other.mStride = 0;
+
+    return *this;
+}
+
+bool MatrixBatch::set(size_t index, size_t row, size_t col, double value)
+{
+    if(index >= mCount || row >= mRows || col >= mCols)
+        return false;
+
+    mData[(row * mCols + col) * mStride + index] = value;
+
+    return true;
+}
+
+bool MatrixBatch::set(size_t index, ConstMatrixView m)
+{
+    if(index >= mCount || m.rows() != mRows || m.cols() != mCols)
+        return false;
+
+    for(size_t r = 0; r < mRows; r++)
+    {
+        for(size_t c = 0; c < mCols; c++)
+            mData[(r * mCols + c) * mStride + index] = m.data()[r * m.stride() + c];
+    }
+
+    return true;
+}
+
+double MatrixBatch::get(size_t index, size_t row, size_t col) const
+{
+    if(index >= mCount || row >= mRows || col >= mCols)
+        throw std::runtime_error("Pristup k indexu mimo matici");
+
+    return mData[(row * mCols + col) * mStride + index];
+}
+
+Matrix MatrixBatch::matrix(size_t index) const
+{
+    if(index >= mCount)
+        throw std::runtime_error("Pristup k indexu mimo matici");
+
+    Matrix result(mRows, mCols);
+
+    for(size_t r = 0; r < mRows; r++)
+    {
+        for(size_t c = 0; c < mCols; c++)
+            result.data()[r * result.stride() + c] = mData[(r * mCols + c) * mStride + index];
+    }
+
+    return result;
+}
+
+void MatrixBatch::checkSmallSquare() const
+{
+    if(mRows != mCols)
+        throw std::runtime_error("Matice musi byt ctvercova.");
+
+    if(mRows > BATCH_MAX_ORDER)
+        throw std::runtime_error("Davkove operace podporuji matice radu nejvyse 4.");
+}
+
+/**
+ * Stejny prvek BATCH_LANES sousednich matic davky. Aritmetika se provadi
+ * po drahach a prekladac ji prevede na SIMD instrukce, vzorce nize tak
+ * pocitaji BATCH_LANES matic najednou.
+ */
+struct Lanes
+{
+    double v[BATCH_LANES];
+};
+
+static inline Lanes operator+(const Lanes &a, const Lanes &b)
+{
+    Lanes r;
+
+    for(size_t w = 0; w < BATCH_LANES; w++)
+        r.v[w] = a.v[w] + b.v[w];
+
+    return r;
+}
+
+static inline Lanes operator-(const Lanes &a, const Lanes &b)
+{
+    Lanes r;
+
+    for(size_t w = 0; w < BATCH_LANES; w++)
+        r.v[w] = a.v[w] - b.v[w];
+
+    return r;
+}
+
+static inline Lanes operator-(const Lanes &a)
+{
+    Lanes r;
+
+    for(size_t w = 0; w < BATCH_LANES; w++)
+        r.v[w] = -a.v[w];
+
+    return r;
+}
+
+static inline Lanes operator*(const Lanes &a, const Lanes &b)
+{
+    Lanes r;
+
+    for(size_t w = 0; w < BATCH_LANES; w++)
+        r.v[w] = a.v[w] * b.v[w];
+
+    return r;
+}
+
+/**
+ * Determinant a adjungovana matice (transponovane algebraicke doplnky)
+ * matic radu 1 az 4 ulozenych po radcich, bez vetveni
+ */
+static Lanes adjugate(const Lanes (&m)[1], Lanes (&adj)[1])
+{
+    for(size_t w = 0; w < BATCH_LANES; w++)
+        adj[0].v[w] = 1;
+
+    return m[0];
+}
+
+static Lanes adjugate(const Lanes (&m)[4], Lanes (&adj)[4])
+{
+    adj[0] = m[3];
+    adj[1] = -m[1];
+    adj[2] = -m[2];
+    adj[3] = m[0];
+
+    return m[0] * m[3] - m[1] * m[2];
+}
+
+static Lanes adjugate(const Lanes (&m)[9], Lanes (&adj)[9])
+{
+    adj[0] = m[4] * m[8] - m[5] * m[7];
+    adj[1] = m[2] * m[7] - m[1] * m[8];
+    adj[2] = m[1] * m[5] - m[2] * m[4];
+    adj[3] = m[5] * m[6] - m[3] * m[8];
+    adj[4] = m[0] * m[8] - m[2] * m[6];
+    adj[5] = m[2] * m[3] - m[0] * m[5];
+    adj[6] = m[3] * m[7] - m[4] * m[6];
+    adj[7] = m[1] * m[6] - m[0] * m[7];
+    adj[8] = m[0] * m[4] - m[1] * m[3];
+
+    return m[0] * adj[0] + m[1] * adj[3] + m[2] * adj[6];
+}
+
+static Lanes adjugate(const Lanes (&m)[16], Lanes (&adj)[16])
+{
+    // Subdeterminanty 2x2 hornich (s) a dolnich (c) dvou radku
+    Lanes s0 = m[0] * m[5] - m[4] * m[1];
+    Lanes s1 = m[0] * m[6] - m[4] * m[2];
+    Lanes s2 = m[0] * m[7] - m[4] * m[3];
+    Lanes s3 = m[1] * m[6] - m[5] * m[2];
+    Lanes s4 = m[1] * m[7] - m[5] * m[3];
+    Lanes s5 = m[2] * m[7] - m[6] * m[3];
+
+    Lanes c5 = m[10] * m[15] - m[14] * m[11];
+    Lanes c4 = m[9] * m[15] - m[13] * m[11];
+    Lanes c3 = m[9] * m[14] - m[13] * m[10];
+    Lanes c2 = m[8] * m[15] - m[12] * m[11];
+    Lanes c1 = m[8] * m[14] - m[12] * m[10];
+    Lanes c0 = m[8] * m[13] - m[12] * m[9];
+
+    adj[0] = m[5] * c5 - m[6] * c4 + m[7] * c3;
+    adj[1] = -m[1] * c5 + m[2] * c4 - m[3] * c3;
+    adj[2] = m[13] * s5 - m[14] * s4 + m[15] * s3;
+    adj[3] = -m[9] * s5 + m[10] * s4 - m[11] * s3;
+    adj[4] = -m[4] * c5 + m[6] * c2 - m[7] * c1;
+    adj[5] = m[0] * c5 - m[2] * c2 + m[3] * c1;
+    adj[6] = -m[12] * s5 + m[14] * s2 - m[15] * s1;
+    adj[7] = m[8] * s5 - m[10] * s2 + m[11] * s1;
+    adj[8] = m[4] * c4 - m[5] * c2 + m[7] * c0;
+    adj[9] = -m[0] * c4 + m[1] * c2 - m[3] * c0;
+    adj[10] = m[12] * s4 - m[13] * s2 + m[15] * s0;
+    adj[11] = -m[8] * s4 + m[9] * s2 - m[11] * s0;
+    adj[12] = -m[4] * c3 + m[5] * c1 - m[6] * c0;
+    adj[13] = m[0] * c3 - m[1] * c1 + m[2] * c0;
+    adj[14] = -m[12] * s3 + m[13] * s1 - m[14] * s0;
+    adj[15] = m[8] * s3 - m[9] * s1 + m[10] * s0;
+
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+/**
+ * Nacte prvky count matic (radku davky o count poli) od matice offset
+ */
+template<size_t count>
+static void loadLanes(const double *data, size_t stride, size_t offset, Lanes (&m)[count])
+{
+    for(size_t k = 0; k < count; k++)
+    {
+        for(size_t w = 0; w < BATCH_LANES; w++)
+            m[k].v[w] = data[k * stride + offset + w];
+    }
+}
+
+/**
+ * Zapise prvnich lanes drah hodnoty value do pole dst
+ */
+static inline void storeLanes(double *dst, const Lanes &value, size_t lanes)
+{
+    if(lanes == BATCH_LANES)
+    {
+        for(size_t w = 0; w < BATCH_LANES; w++)
+            dst[w] = value.v[w];
+    }
+    else
+    {
+        for(size_t w = 0; w < lanes; w++)
+            dst[w] = value.v[w];
+    }
+}
+
+/**
+ * Determinanty, inverze nebo reseni soustav pro bloky [begin, end) davky a.
+ * Prvky za posledni matici (vypln) se pocitaji s ostatnimi, ale nezapisuji.
+ *
+ * @param      det    determinanty (nebo nullptr)
+ * @param      b      prave strany (nullptr pro inverzi)
+ * @param      x      inverze nebo reseni (nullptr pro determinant)
+ *
+ * @return     pocet singularnich matic
+ */
+template<size_t N>
+static size_t processBlocks(const MatrixBatch &a, const MatrixBatch *b, MatrixBatch *x, double *det,
+                            size_t begin, size_t end)
+{
+    const size_t s = a.stride();
+    size_t singular = 0;
+
+    for(size_t block = begin; block < end; block++)
+    {
+        const size_t offset = block * BATCH_LANES;
+        const size_t lanes = a.size() - offset < BATCH_LANES ? a.size() - offset : BATCH_LANES;
+        Lanes m[N * N];
+        Lanes adj[N * N];
+
+        loadLanes(a.data(), s, offset, m);
+
+        Lanes d = adjugate(m, adj);
+
+        for(size_t w = 0; w < lanes; w++)
+        {
+            singular += d.v[w] == 0;
+
+            if(det != nullptr)
+                det[offset + w] = d.v[w];
+        }
+
+        if(x == nullptr)
+            continue;
+
+        Lanes inverse;
+
+        for(size_t w = 0; w < BATCH_LANES; w++)
+            inverse.v[w] = 1 / d.v[w];
+
+        if(b == nullptr)
+        {
+            for(size_t k = 0; k < N * N; k++)
+                storeLanes(x->data() + k * s + offset, adj[k] * inverse, lanes);
+
+            continue;
+        }
+
+        Lanes rhs[N];
+
+        loadLanes(b->data(), s, offset, rhs);
+
+        for(size_t r = 0; r < N; r++)
+        {
+            Lanes sum = adj[r * N] * rhs[0];
+
+            for(size_t c = 1; c < N; c++)
+                sum = sum + adj[r * N + c] * rhs[c];
+
+            storeLanes(x->data() + r * s + offset, sum * inverse, lanes);
+        }
+    }
+
+    return singular;
+}
+
+/**
+ * Rozdeli bloky davky mezi vlakna (male davky zpracuje primo)
+ *
+ * @return     pocet singularnich matic
+ */
+template<size_t N>
+static size_t processBatch(ThreadPool *pool, const MatrixBatch &a, const MatrixBatch *b,
+                           MatrixBatch *x, double *det)
+{
+    size_t blocks = (a.size() + BATCH_LANES - 1) / BATCH_LANES;
+    size_t parts = 1;
+
+    if(a.size() >= BATCH_PARALLEL_MIN)
+    {
+        if(pool == nullptr)
+            pool = &ThreadPool::shared();
+
+        parts = pool->size() < blocks ? pool->size() : blocks;
+    }
+
+    if(parts <= 1)
+        return processBlocks<N>(a, b, x, det, 0, blocks);
+
+    std::atomic<size_t> singular(0);
+
+    pool->parallelFor(parts, [&](size_t part) {
+        singular += processBlocks<N>(a, b, x, det, blocks * part / parts, blocks * (part + 1) / parts);
+    });
+
+    return singular;
+}
+
+/**
+ * Vybere jadro podle radu matic davky a
+ */
+static size_t processBatch(ThreadPool *pool, const MatrixBatch &a, const MatrixBatch *b,
+                           MatrixBatch *x, double *det)
+{
+    switch(a.rows())
+    {
+        case 1: return processBatch<1>(pool, a, b, x, det);
+        case 2: return processBatch<2>(pool, a, b, x, det);
+        case 3: return processBatch<3>(pool, a, b, x, det);
+        default: return processBatch<4>(pool, a, b, x, det);
+    }
+}
+
+std::vector<double> MatrixBatch::determinant(ThreadPool *pool) const
+{
+    checkSmallSquare();
+
+    std::vector<double> result(mCount);
+
+    processBatch(pool, *this, nullptr, nullptr, result.data());
+
+    return result;
+}
+
+MatrixBatch MatrixBatch::inverse(ThreadPool *pool) const
+{
+    checkSmallSquare();
+
+    MatrixBatch result(mRows, mCols, mCount);
+
+    if(processBatch(pool, *this, nullptr, &result, nullptr) > 0)
+        throw std::runtime_error("Matice je singularni.");
+
+    return result;
+}
+
+MatrixBatch MatrixBatch::solveEquation(const MatrixBatch &b, ThreadPool *pool) const
+{
+    checkSmallSquare();
+
+    if(b.mRows != mRows || b.mCols != 1 || b.mCount != mCount)
+        throw std::runtime_error("Pocet prvku prave strany rovnice musi odpovidat poctu radku matice.");
+
+    MatrixBatch result(mRows, 1, mCount);
+
+    if(processBatch(pool, *this, &b, &result, nullptr) > 0)
+        throw std::runtime_error("Matice je singularni.");
+
+    return result;
+}
+
+/*** Konec souboru matrix_batch.cpp ***/
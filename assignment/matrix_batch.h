@@ -0,0 +1,157 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - batches of small matrices
+//
+// $NoKeywords: $ivs_project_1 $matrix_batch.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file matrix_batch.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Davka mnoha malych matic stejne velikosti ulozena po slozkach
+ *        (structure of arrays). Stejny prvek vsech matic lezi v jednom
+ *        souvislem poli, operace tak zpracuji nekolik matic najednou
+ *        v SIMD registrech bez zavislosti mezi drahami a bez rezie
+ *        jednotlivych objektu Matrix.
+ */
+
+#pragma once
+
+#ifndef MATRIX_BATCH_H_
+#define MATRIX_BATCH_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "white_box_code.h"
+
+class ThreadPool;
+
+/**
+ * @brief Davka size() matic rows() x cols()
+ * Operace determinant, inverse a solveEquation jsou pro ctvercove matice
+ * radu 1 az 4, pro ostatni vyhodi std::runtime_error. Prvek [r][c] matice
+ * s indexem i lezi na data()[(r * cols() + c) * stride() + i]. Pole
+ * kazdeho prvku je zarovnane na MATRIX_ALIGN_BYTES a vypln za posledni
+ * matici je nulova.
+ */
+class MatrixBatch
+{
+public:
+  /**
+   * @brief MatrixBatch
+   * Konstruktor vytvori davku count nulovych matic row x col
+   */
+  MatrixBatch(size_t row, size_t col, size_t count);
+
+  MatrixBatch(const MatrixBatch &other);
+
+  MatrixBatch(MatrixBatch &&other);
+
+  ~MatrixBatch();
+
+  MatrixBatch &operator=(const MatrixBatch &other);
+
+  MatrixBatch &operator=(MatrixBatch &&other);
+
+  /**
+   * @brief      set
+   *      * nastavi prvek row, col matice s indexem index
+   *
+   * @return     pokud bylo vlozeni uspesne vrati true, jinak false
+   */
+  bool set(size_t index, size_t row, size_t col, double value);
+
+  /**
+   * @brief      set
+   *      * nastavi celou matici s indexem index
+   *
+   * @return     pokud ma matice spravnou velikost a index je v davce
+   *             vrati true, jinak false
+   */
+  bool set(size_t index, ConstMatrixView m);
+
+  /**
+   * @brief      get
+   *      * vrati prvek row, col matice s indexem index
+   */
+  double get(size_t index, size_t row, size_t col) const;
+
+  /**
+   * @brief      kopie matice s indexem index
+   */
+  Matrix matrix(size_t index) const;
+
+  /**
+   * @brief      determinanty vsech matic davky
+   *        * pevne vzorce (rozvoj podle subdeterminantu 2x2) bez vetveni,
+   *          nekolik matic v jedne SIMD operaci. Inverze a reseni
+   *          soustav pouzivaji adjungovanou matici stejne jako
+   *          Matrix::inverse pro rady 2 a 3, pro spatne podminene matice
+   *          jsou proto mene presne nez LU rozklad s pivotaci.
+   *
+   * @param      pool   fond vlaken (nullptr znamena ThreadPool::shared())
+   *
+   * @return     pole size() determinantu
+   */
+  std::vector<double> determinant(ThreadPool *pool = nullptr) const;
+
+  /**
+   * @brief      inverze vsech matic davky, A^-1 = adj(A) / det(A)
+   *        * pokud je nektera matice singularni, vyhodi std::runtime_error
+   *
+   * @return     davka invertovanych matic
+   */
+  MatrixBatch inverse(ThreadPool *pool = nullptr) const;
+
+  /**
+   * @brief      reseni soustav A_i x_i = b_i pro vsechny matice davky
+   *        * x = adj(A) b / det(A) (Cramerovo pravidlo), pokud je nektera
+   *          matice singularni, vyhodi std::runtime_error
+   *
+   * @param      b      davka pravych stran (rows() x 1, stejny pocet)
+   *
+   * @return     davka reseni (rows() x 1)
+   */
+  MatrixBatch solveEquation(const MatrixBatch &b, ThreadPool *pool = nullptr) const;
+
+  size_t rows() const { return mRows; }
+
+  size_t cols() const { return mCols; }
+
+  /**
+   * @brief      pocet matic v davce
+   */
+  size_t size() const { return mCount; }
+
+  /**
+   * @brief      vzdalenost (v prvcich) mezi poli dvou sousednich prvku,
+   *             vzdy nasobek MATRIX_ALIGN_ELEMS
+   */
+  size_t stride() const { return mStride; }
+
+  double *data() { return mData; }
+  const double *data() const { return mData; }
+
+protected:
+  double *mData;
+
+  size_t mRows;
+
+  size_t mCols;
+
+  size_t mCount;
+
+  size_t mStride;
+
+  /**
+   * @brief      kontrola ctvercovych matic radu 1 az 4
+   */
+  void checkSmallSquare() const;
+};
+
+#endif /* MATRIX_BATCH_H_ */
+
+/*** Konec souboru matrix_batch.h ***/
@@ -0,0 +1,216 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - lazy element-wise matrix expressions
+//
+// $NoKeywords: $ivs_project_1 $matrix_expr.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file matrix_expr.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Sablony vyrazu (expression templates) pro odlozene prvkove operace
+ *        s maticemi. Vyraz jako lazy(A) * 2.0 + B + C nevytvari zadne
+ *        mezivysledky, cely se vyhodnoti jednim pruchodem az pri prirazeni
+ *        do matice.
+ *
+ * Vyraz si pamatuje pouze ukazatele na data operandu, musi proto byt
+ * vyhodnocen drive, nez operandy zaniknou (typicky ve stejnem prikazu).
+ * Vysledek smi byt prirazen i do nektereho z operandu, kazdy prvek vysledku
+ * zavisi jen na prvcich operandu na stejne pozici.
+ */
+
+#pragma once
+
+#ifndef MATRIX_EXPR_H_
+#define MATRIX_EXPR_H_
+
+#include <stdexcept>
+
+#include "white_box_code.h"
+
+/**
+ * @brief Spolecny predek vsech vyrazu (CRTP)
+ * Potomek E poskytuje rows(), cols() a hodnotu prvku operator()(row, col).
+ */
+template<class E>
+class MatrixExpr
+{
+public:
+  const E &self() const { return static_cast<const E &>(*this); }
+
+  size_t rows() const { return self().rows(); }
+
+  size_t cols() const { return self().cols(); }
+
+  double operator()(size_t row, size_t col) const { return self()(row, col); }
+};
+
+/**
+ * @brief List vyrazu odkazujici na existujici matici
+ */
+class MatrixLeaf : public MatrixExpr<MatrixLeaf>
+{
+public:
+  explicit MatrixLeaf(const Matrix &m): mData(m.data()), mRows(m.rows()), mCols(m.cols()), mStride(m.stride()) {}
+
+  size_t rows() const { return mRows; }
+
+  size_t cols() const { return mCols; }
+
+  double operator()(size_t row, size_t col) const { return mData[row * mStride + col]; }
+
+protected:
+  const double *mData;
+  size_t mRows;
+  size_t mCols;
+  size_t mStride;
+};
+
+/**
+ * @brief Soucet (Sign = 1) nebo rozdil (Sign = -1) dvou vyrazu
+ */
+template<class L, class R, int Sign>
+class MatrixSum : public MatrixExpr<MatrixSum<L, R, Sign> >
+{
+public:
+  MatrixSum(const L &left, const R &right): mLeft(left), mRight(right)
+  {
+    if(left.rows() != right.rows() || left.cols() != right.cols())
+      throw std::runtime_error("Matice musi mit stejnou velikost.");
+  }
+
+  size_t rows() const { return mLeft.rows(); }
+
+  size_t cols() const { return mLeft.cols(); }
+
+  double operator()(size_t row, size_t col) const
+  {
+    return Sign > 0 ? mLeft(row, col) + mRight(row, col) : mLeft(row, col) - mRight(row, col);
+  }
+
+protected:
+  L mLeft;
+  R mRight;
+};
+
+/**
+ * @brief Nasobek vyrazu skalarem
+ */
+template<class E>
+class MatrixScaled : public MatrixExpr<MatrixScaled<E> >
+{
+public:
+  MatrixScaled(const E &expr, double value): mExpr(expr), mValue(value) {}
+
+  size_t rows() const { return mExpr.rows(); }
+
+  size_t cols() const { return mExpr.cols(); }
+
+  double operator()(size_t row, size_t col) const { return mValue * mExpr(row, col); }
+
+protected:
+  E mExpr;
+  double mValue;
+};
+
+/**
+ * @brief      lazy
+ *        * zacatek odlozeneho vyrazu nad matici m
+ *
+ * @param      m     matice
+ *
+ * @return     list vyrazu odkazujici na m
+ */
+inline MatrixLeaf lazy(const Matrix &m)
+{
+  return MatrixLeaf(m);
+}
+
+template<class L, class R>
+MatrixSum<L, R, 1> operator+(const MatrixExpr<L> &left, const MatrixExpr<R> &right)
+{
+  return MatrixSum<L, R, 1>(left.self(), right.self());
+}
+
+template<class L>
+MatrixSum<L, MatrixLeaf, 1> operator+(const MatrixExpr<L> &left, const Matrix &right)
+{
+  return MatrixSum<L, MatrixLeaf, 1>(left.self(), MatrixLeaf(right));
+}
+
+template<class R>
+MatrixSum<MatrixLeaf, R, 1> operator+(const Matrix &left, const MatrixExpr<R> &right)
+{
+  return MatrixSum<MatrixLeaf, R, 1>(MatrixLeaf(left), right.self());
+}
+
+template<class L, class R>
+MatrixSum<L, R, -1> operator-(const MatrixExpr<L> &left, const MatrixExpr<R> &right)
+{
+  return MatrixSum<L, R, -1>(left.self(), right.self());
+}
+
+template<class L>
+MatrixSum<L, MatrixLeaf, -1> operator-(const MatrixExpr<L> &left, const Matrix &right)
+{
+  return MatrixSum<L, MatrixLeaf, -1>(left.self(), MatrixLeaf(right));
+}
+
+template<class R>
+MatrixSum<MatrixLeaf, R, -1> operator-(const Matrix &left, const MatrixExpr<R> &right)
+{
+  return MatrixSum<MatrixLeaf, R, -1>(MatrixLeaf(left), right.self());
+}
+
+template<class E>
+MatrixScaled<E> operator*(const MatrixExpr<E> &expr, double value)
+{
+  return MatrixScaled<E>(expr.self(), value);
+}
+
+template<class E>
+MatrixScaled<E> operator*(double value, const MatrixExpr<E> &expr)
+{
+  return MatrixScaled<E>(expr.self(), value);
+}
+
+template<class E>
+Matrix::BasicMatrix(const MatrixExpr<E> &expr)
+{
+  allocate(expr.rows(), expr.cols(), false);
+  assignExpr(expr.self());
+}
+
+template<class E>
+Matrix &Matrix::operator=(const MatrixExpr<E> &expr)
+{
+  if(mRows != expr.rows() || mCols != expr.cols() || mData == nullptr)
+  {
+    Matrix result(expr);
+    return *this = std::move(result);
+  }
+
+  assignExpr(expr.self());
+
+  return *this;
+}
+
+template<class E>
+void Matrix::assignExpr(const E &expr)
+{
+  // Jediny pruchod po radcich, vnitrni smycka je po inlinovani vyrazu
+  // souvisla a prekladac ji muze vektorizovat
+  for(size_t r = 0; r < mRows; r++)
+  {
+    double *row = mData + r * mStride;
+
+    for(size_t c = 0; c < mCols; c++)
+      row[c] = expr(r, c);
+  }
+}
+
+#endif /* MATRIX_EXPR_H_ */
+
+/*** Konec souboru matrix_expr.h ***/
@@ -0,0 +1,299 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - binary matrix files and memory mapping
+//
+// $NoKeywords: $ivs_project_1 $matrix_file.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file matrix_file.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Zapis binarnich souboru s matici, overeni hlavicky a mapovani
+ *        souboru do pameti (POSIX mmap, na Windows MapViewOfFile).
+ */
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "matrix_file.h"
+
+static_assert(sizeof(MatrixFileHeader) == 64, "Hlavicka souboru matice musi mit 64 bajtu.");
+
+static const char MATRIX_FILE_MAGIC[8] = { 'I', 'V', 'S', 'M', 'A', 'T', 'R', 'X' };
+
+static const char zeros[MATRIX_ALIGN_BYTES] = {};
+
+/**
+ * Hlavicka souboru s matici rows x cols prvku velikosti elem, radky
+ * zarovnane na MATRIX_ALIGN_BYTES
+ */
+static MatrixFileHeader makeHeader(uint32_t dtype, size_t elem, size_t rows, size_t cols)
+{
+    const size_t align = MATRIX_ALIGN_BYTES / elem;
+
+    MatrixFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MATRIX_FILE_MAGIC, sizeof(header.magic));
+    header.byteOrder = MATRIX_FILE_BYTE_ORDER;
+    header.version = MATRIX_FILE_VERSION;
+    header.dtype = dtype;
+    header.layout = MATRIX_FILE_ROW_MAJOR;
+    header.rows = rows;
+    header.cols = cols;
+    header.stride = (cols + align - 1) / align * align;
+    header.alignment = MATRIX_ALIGN_BYTES;
+    header.dataOffset = (sizeof(header) + MATRIX_ALIGN_BYTES - 1) / MATRIX_ALIGN_BYTES * MATRIX_ALIGN_BYTES;
+
+    return header;
+}
+
+/**
+ * Otevre soubor pro zapis a zapise hlavicku vcetne vyplne do dataOffset
+ */
+static void writeHeader(std::ofstream &out, const std::string &path, const MatrixFileHeader &header)
+{
+    out.open(path.c_str(), std::ios::binary | std::ios::trunc);
+
+    if(!out)
+        throw std::runtime_error("Soubor matice nelze otevrit pro zapis.");
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(zeros, header.dataOffset - sizeof(header));
+}
+
+/**
+ * Zapise hlavicku a radky matice typu T, vypln radku je vzdy nulova
+ * (i kdyz je zdroj pohled do sirsi matice)
+ */
+template<class T>
+static void writeRows(const std::string &path, uint32_t dtype, size_t rows, size_t cols,
+                      const T *data, size_t stride)
+{
+    MatrixFileHeader header = makeHeader(dtype, sizeof(T), rows, cols);
+    std::ofstream out;
+
+    writeHeader(out, path, header);
+
+    for(size_t r = 0; r < rows; r++)
+    {
+        out.write(reinterpret_cast<const char *>(data + r * stride), cols * sizeof(T));
+        out.write(zeros, (header.stride - cols) * sizeof(T));
+    }
+
+    out.close();
+
+    if(!out)
+        throw std::runtime_error("Soubor matice nelze zapsat.");
+}
+
+void writeMatrixFile(const std::string &path, ConstMatrixView m)
+{
+    writeRows(path, MATRIX_FILE_F64, m.rows(), m.cols(), m.data(), m.stride());
+}
+
+void writeMatrixFile(const std::string &path, const MatrixF &m)
+{
+    writeRows(path, MATRIX_FILE_F32, m.rows(), m.cols(), m.data(), m.stride());
+}
+
+MatrixFileHeader createMatrixFile(const std::string &path, size_t rows, size_t cols)
+{
+    if(rows < 1 || cols < 1)
+        throw std::runtime_error("Minimalni velikost matice je 1x1");
+
+    MatrixFileHeader header = makeHeader(MATRIX_FILE_F64, sizeof(double), rows, cols);
+
+    if(rows > (std::numeric_limits<uint64_t>::max() - header.dataOffset) / (header.stride * sizeof(double)))
+        throw std::length_error("Matice je prilis velka.");
+
+    std::ofstream out;
+
+    writeHeader(out, path, header);
+
+    // Zapis posledniho bajtu prodlouzi soubor, zbytek se cte jako nuly
+    out.seekp(header.dataOffset + header.rows * header.stride * sizeof(double) - 1);
+    out.write(zeros, 1);
+    out.close();
+
+    if(!out)
+        throw std::runtime_error("Soubor matice nelze zapsat.");
+
+    return header;
+}
+
+/**
+ * Overi hlavicku proti velikosti souboru, pri chybe vyhodi std::runtime_error
+ */
+static void checkHeader(const MatrixFileHeader &h, uint64_t fileSize)
+{
+    if(memcmp(h.magic, MATRIX_FILE_MAGIC, sizeof(h.magic)) != 0)
+        throw std::runtime_error("Soubor neni soubor matice.");
+
+    if(h.byteOrder != MATRIX_FILE_BYTE_ORDER)
+        throw std::runtime_error("Soubor matice ma jine poradi bajtu.");
+
+    if(h.version != MATRIX_FILE_VERSION)
+        throw std::runtime_error("Nepodporovana verze souboru matice.");
+
+    if((h.dtype != MATRIX_FILE_F64 && h.dtype != MATRIX_FILE_F32) || h.layout != MATRIX_FILE_ROW_MAJOR)
+        throw std::runtime_error("Nepodporovany typ prvku nebo rozlozeni souboru matice.");
+
+    const uint64_t elem = h.dtype == MATRIX_FILE_F64 ? sizeof(double) : sizeof(float);
+    const uint64_t maxSize = std::numeric_limits<uint64_t>::max();
+
+    if(h.rows < 1 || h.cols < 1 || h.stride < h.cols || h.stride > maxSize / elem ||
+       h.alignment < elem || (h.alignment & (h.alignment - 1)) != 0 ||
+       (h.stride * elem) % h.alignment != 0 || h.dataOffset % h.alignment != 0 ||
+       h.dataOffset < sizeof(MatrixFileHeader))
+        throw std::runtime_error("Soubor matice ma neplatnou hlavicku.");
+
+    if(h.rows > (maxSize - h.dataOffset) / (h.stride * elem) ||
+       fileSize < h.dataOffset + h.rows * h.stride * elem)
+        throw std::runtime_error("Soubor matice je zkraceny.");
+
+    if(h.rows * h.stride > std::numeric_limits<size_t>::max() / elem)
+        throw std::runtime_error("Soubor matice je prilis velky.");
+}
+
+MatrixFileHeader readMatrixFileHeader(const std::string &path)
+{
+    std::ifstream in(path.c_str(), std::ios::binary);
+
+    if(!in)
+        throw std::runtime_error("Soubor matice nelze otevrit.");
+
+    MatrixFileHeader header;
+
+    if(!in.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        throw std::runtime_error("Soubor neni soubor matice.");
+
+    in.seekg(0, std::ios::end);
+    checkHeader(header, static_cast<uint64_t>(in.tellg()));
+
+    return header;
+}
+
+MappedMatrixFile::MappedMatrixFile(const std::string &path): mMapping(nullptr), mLength(0)
+{
+    uint64_t size = 0;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if(file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Soubor matice nelze otevrit.");
+
+    LARGE_INTEGER fileSize;
+
+    if(GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= (LONGLONG) sizeof(MatrixFileHeader))
+    {
+        size = fileSize.QuadPart;
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if(mapping != nullptr)
+        {
+            mMapping = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+
+    CloseHandle(file);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if(fd < 0)
+        throw std::runtime_error("Soubor matice nelze otevrit.");
+
+    struct stat info;
+
+    if(fstat(fd, &info) == 0 && info.st_size >= (off_t) sizeof(MatrixFileHeader))
+    {
+        size = info.st_size;
+
+        // Mapovani zustava platne i po zavreni deskriptoru
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+        if(mapping != MAP_FAILED)
+            mMapping = static_cast<const char *>(mapping);
+    }
+
+    close(fd);
+#endif
+
+    if(mMapping == nullptr)
+        throw std::runtime_error("Soubor neni soubor matice.");
+
+    mLength = size;
+    memcpy(&mHeader, mMapping, sizeof(mHeader));
+
+    try
+    {
+        checkHeader(mHeader, size);
+    }
+    catch(...)
+    {
+        unmap();
+        throw;
+    }
+}
+
+MappedMatrixFile::MappedMatrixFile(MappedMatrixFile &&other):
+    mHeader(other.mHeader), mMapping(other.mMapping), mLength(other.mLength)
+{
+    other.mMapping = nullptr;
+    other.mLength = 0;
+}
+
+MappedMatrixFile &MappedMatrixFile::operator=(MappedMatrixFile &&other)
+{
+    if(this == &other)
+        return *this;
+
+    unmap();
+
+    mHeader = other.mHeader;
+    mMapping = other.mMapping;
+    mLength = other.mLength;
+
+    other.mMapping = nullptr;
+    other.mLength = 0;
+
+    return *this;
+}
+
+MappedMatrixFile::~MappedMatrixFile()
+{
+    unmap();
+}
+
+void MappedMatrixFile::unmap()
+{
+    if(mMapping == nullptr)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mMapping);
+#else
+    munmap(const_cast<char *>(mMapping), mLength);
+#endif
+
+    mMapping = nullptr;
+    mLength = 0;
+}
+
+/*** Konec souboru matrix_file.cpp ***/
@@ -0,0 +1,183 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - binary matrix files and memory mapping
+//
+// $NoKeywords: $ivs_project_1 $matrix_file.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file matrix_file.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Binarni format souboru s matici a jeho nacteni mapovanim do
+ *        pameti (mmap) bez kopirovani a bez parsovani.
+ *
+ * Soubor zacina 64 bajtovou hlavickou MatrixFileHeader, od dataOffset
+ * nasleduji radky matice ve stejnem rozlozeni jako v pameti tridy Matrix:
+ * kazdy radek ma stride prvku a zacina na adrese zarovnane na alignment,
+ * vypln za poslednim sloupcem je nulova. Cisla jsou v nativnim poradi
+ * bajtu, soubor z jineho poradi bajtu je odmitnut.
+ */
+
+#pragma once
+
+#ifndef MATRIX_FILE_H_
+#define MATRIX_FILE_H_
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "white_box_code.h"
+
+/**
+ * Typ prvku ulozenych v souboru
+ */
+enum MatrixFileDtype
+{
+  MATRIX_FILE_F64 = 1,    ///< double
+  MATRIX_FILE_F32 = 2     ///< float
+};
+
+/**
+ * Rozlozeni dat v souboru
+ */
+enum MatrixFileLayout
+{
+  MATRIX_FILE_ROW_MAJOR = 0   ///< po radcich se vzdalenosti radku stride
+};
+
+/**
+ * @brief Hlavicka souboru s matici (64 bajtu)
+ */
+struct MatrixFileHeader
+{
+  char magic[8];            ///< "IVSMATRX"
+  uint32_t byteOrder;       ///< MATRIX_FILE_BYTE_ORDER v poradi bajtu zapisujiciho stroje
+  uint32_t version;         ///< verze formatu (MATRIX_FILE_VERSION)
+  uint32_t dtype;           ///< MatrixFileDtype
+  uint32_t layout;          ///< MatrixFileLayout
+  uint64_t rows;            ///< pocet radku
+  uint64_t cols;            ///< pocet sloupcu
+  uint64_t stride;          ///< vzdalenost (v prvcich) mezi zacatky radku
+  uint64_t alignment;       ///< zarovnani dat a radku v bajtech
+  uint64_t dataOffset;      ///< pozice prvku [0][0] od zacatku souboru v bajtech
+};
+
+const uint32_t MATRIX_FILE_BYTE_ORDER = 0x01020304;
+
+const uint32_t MATRIX_FILE_VERSION = 1;
+
+/**
+ * @brief      writeMatrixFile
+ *        * zapise matici (pohled) typu double do binarniho souboru, radky
+ *          se zarovnanim MATRIX_ALIGN_BYTES
+ *
+ * @param      path  cesta k souboru (existujici soubor se prepise)
+ * @param      m     zapisovana matice
+ */
+void writeMatrixFile(const std::string &path, ConstMatrixView m);
+
+/**
+ * @brief      writeMatrixFile
+ *        * zapise matici typu float
+ */
+void writeMatrixFile(const std::string &path, const MatrixF &m);
+
+/**
+ * @brief      createMatrixFile
+ *        * vytvori soubor s nulovou matici typu double velikosti rows x
+ *          cols bez zapisu dat (na systemech s ridkymi soubory nezabira
+ *          misto), data se pak zapisuji po castech (viz OutOfCore)
+ *
+ * @return     hlavicka vytvoreneho souboru
+ */
+MatrixFileHeader createMatrixFile(const std::string &path, size_t rows, size_t cols);
+
+/**
+ * @brief      readMatrixFileHeader
+ *        * precte a overi hlavicku souboru (magic, poradi bajtu, verze,
+ *          typ, rozlozeni, zarovnani a velikost souboru). Pri chybe vyhodi
+ *          std::runtime_error.
+ *
+ * @param      path  cesta k souboru
+ *
+ * @return     hlavicka souboru
+ */
+MatrixFileHeader readMatrixFileHeader(const std::string &path);
+
+/**
+ * @brief Soubor s matici namapovany do pameti pouze pro cteni
+ * Nacteni trva jen overeni hlavicky a volani mmap, stranky se ctou az pri
+ * prvnim pristupu (a sdileji se s cache souboru operacniho systemu).
+ * Pohledy vracene view() jsou platne, dokud objekt existuje.
+ */
+class MappedMatrixFile
+{
+public:
+  /**
+   * @brief MappedMatrixFile
+   * Konstruktor overi hlavicku a namapuje soubor, pri chybe vyhodi
+   * std::runtime_error
+   *
+   * @param      path  cesta k souboru
+   */
+  explicit MappedMatrixFile(const std::string &path);
+
+  MappedMatrixFile(MappedMatrixFile &&other);
+
+  MappedMatrixFile &operator=(MappedMatrixFile &&other);
+
+  MappedMatrixFile(const MappedMatrixFile &) = delete;
+
+  MappedMatrixFile &operator=(const MappedMatrixFile &) = delete;
+
+  ~MappedMatrixFile();
+
+  const MatrixFileHeader &header() const { return mHeader; }
+
+  size_t rows() const { return mHeader.rows; }
+
+  size_t cols() const { return mHeader.cols; }
+
+  MatrixFileDtype dtype() const { return static_cast<MatrixFileDtype>(mHeader.dtype); }
+
+  /**
+   * @brief      view
+   *        * pohled na namapovana data bez kopie, T musi odpovidat typu
+   *          prvku v souboru (double nebo float), jinak vyhodi
+   *          std::runtime_error. Pro zapisovatelnou kopii staci
+   *          Matrix(file.view<double>()).
+   *
+   * @return     pohled pouze pro cteni
+   */
+  template<class T>
+  BasicMatrixView<const T> view() const
+  {
+    if(mHeader.dtype != dtypeOf(static_cast<const T *>(nullptr)))
+      throw std::runtime_error("Typ prvku neodpovida souboru matice.");
+
+    return BasicMatrixView<const T>(reinterpret_cast<const T *>(mMapping + mHeader.dataOffset),
+                                    mHeader.rows, mHeader.cols, mHeader.stride);
+  }
+
+protected:
+  MatrixFileHeader mHeader;
+
+  const char *mMapping;
+
+  size_t mLength;
+
+  static uint32_t dtypeOf(const double *) { return MATRIX_FILE_F64; }
+  static uint32_t dtypeOf(const float *) { return MATRIX_FILE_F32; }
+
+  /**
+   * @brief      zrusi mapovani
+   */
+  void unmap();
+};
+
+#endif /* MATRIX_FILE_H_ */
+
+/*** Konec souboru matrix_file.h ***/
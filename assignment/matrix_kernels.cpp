@@ -0,0 +1,1562 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - low level matrix kernels
+//
+// $NoKeywords: $ivs_project_1 $matrix_kernels.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file matrix_kernels.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Definice nizkourovnovych vypocetnich jader nad maticemi.
+ */
+
+#include <atomic>
+#include <new>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include "matrix_kernels.h"
+#include "thread_pool.h"
+
+namespace MatrixKernels
+{
+
+static std::atomic<size_t> allocCount(0);
+
+void *alignedAllocBytes(size_t bytes)
+{
+    void *ptr = nullptr;
+
+    allocCount++;
+
+    if(bytes == 0)
+        bytes = 1;
+
+#ifdef _WIN32
+    ptr = _aligned_malloc(bytes, MATRIX_ALIGN_BYTES);
+#else
+    if(posix_memalign(&ptr, MATRIX_ALIGN_BYTES, bytes) != 0)
+        ptr = nullptr;
+#endif
+
+    if(ptr == nullptr)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+double *alignedAlloc(size_t count)
+{
+    return static_cast<double *>(alignedAllocBytes(count * sizeof(double)));
+}
+
+void alignedFree(void *ptr)
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+size_t alignedAllocCount()
+{
+    return allocCount;
+}
+
+/**
+ * Pracovni pamet pro zabalene bloky gemm. Roste podle potreby a drzi se
+ * mezi volanimi, opakovane soucitny stejne velikosti (iteracni smycky)
+ * tak po prvnim volani nealokuji. Nejvetsi velikost je dana bloky
+ * GEMM_MC x GEMM_KC a GEMM_KC x GEMM_NC.
+ */
+struct PackBuffer
+{
+    void *data;
+    size_t bytes;
+
+    PackBuffer(): data(nullptr), bytes(0) {}
+
+    ~PackBuffer()
+    {
+        alignedFree(data);
+    }
+
+    void *reserve(size_t need)
+    {
+        if(need > bytes)
+        {
+            alignedFree(data);
+            data = nullptr;
+            bytes = 0;
+
+            data = alignedAllocBytes(need);
+            bytes = need;
+        }
+
+        return data;
+    }
+};
+
+// gemm nevola zadne jine gemm ani neceka na ulohy, jedno uloziste
+// na vlakno proto staci
+static thread_local PackBuffer packBufferA, packBufferB;
+
+/**
+ * Sirka dlazdice mikro-jadra v prvcich typu T. Dlazdice zabira stejny pocet
+ * bajtu (registru) jako GEMM_NR prvku double, pro float je dvakrat sirsi.
+ */
+template<class T>
+static constexpr size_t gemmNr()
+{
+    return GEMM_NR * sizeof(double) / sizeof(T);
+}
+
+/**
+ * Zabaleni bloku A (mc x kc) do pruhu po GEMM_MR radcich. Uvnitr pruhu jsou
+ * prvky ulozeny po sloupcich, chybejici radky posledniho pruhu jsou nulove.
+ */
+template<class T>
+static void packA(Op op, size_t mc, size_t kc, const T *A, size_t lda, T *packed)
+{
+    // Prvek (i, p) operandu op(A) lezi na A[i * rs + p * cs]
+    const size_t rs = op == NO_TRANS ? lda : 1;
+    const size_t cs = op == NO_TRANS ? 1 : lda;
+
+    for(size_t i = 0; i < mc; i += GEMM_MR)
+    {
+        size_t mr = mc - i < GEMM_MR ? mc - i : GEMM_MR;
+
+        for(size_t p = 0; p < kc; p++)
+        {
+            for(size_t ii = 0; ii < mr; ii++)
+                packed[ii] = A[(i + ii) * rs + p * cs];
+            for(size_t ii = mr; ii < GEMM_MR; ii++)
+                packed[ii] = 0;
+
+            packed += GEMM_MR;
+        }
+    }
+}
+
+/**
+ * Zabaleni panelu B (kc x nc) do pruhu po gemmNr<T>() sloupcich. Uvnitr
+ * pruhu jsou prvky ulozeny po radcich, chybejici sloupce posledniho pruhu
+ * jsou nulove.
+ */
+template<class T>
+static void packB(Op op, size_t kc, size_t nc, const T *B, size_t ldb, T *packed)
+{
+    const size_t NR = gemmNr<T>();
+
+    // Prvek (p, j) operandu op(B) lezi na B[p * rs + j * cs]
+    const size_t rs = op == NO_TRANS ? ldb : 1;
+    const size_t cs = op == NO_TRANS ? 1 : ldb;
+
+    for(size_t j = 0; j < nc; j += NR)
+    {
+        size_t nr = nc - j < NR ? nc - j : NR;
+
+        for(size_t p = 0; p < kc; p++)
+        {
+            const T *row = B + p * rs + j * cs;
+
+            for(size_t jj = 0; jj < nr; jj++)
+                packed[jj] = row[jj * cs];
+            for(size_t jj = nr; jj < NR; jj++)
+                packed[jj] = 0;
+
+            packed += NR;
+        }
+    }
+}
+
+/**
+ * Mikro-jadro: dlazdice GEMM_MR x gemmNr<T>() vysledku je akumulovana
+ * v lokalnim poli (registrech) pres celou delku kc a do C se zapise jen
+ * jednou. Okrajove dlazdice (mr < GEMM_MR nebo nr < gemmNr<T>()) zapisi
+ * pouze platnou cast.
+ */
+template<class T>
+static void microKernel(size_t kc, const T *a, const T *b,
+                        T alpha, T beta, T *C, size_t ldc,
+                        size_t mr, size_t nr)
+{
+    const size_t NR = gemmNr<T>();
+    T ab[GEMM_MR * NR];
+
+    for(size_t i = 0; i < GEMM_MR * NR; i++)
+        ab[i] = 0;
+
+    for(size_t p = 0; p < kc; p++)
+    {
+        for(size_t i = 0; i < GEMM_MR; i++)
+        {
+            const T ai = a[i];
+
+            for(size_t j = 0; j < NR; j++)
+                ab[i * NR + j] += ai * b[j];
+        }
+
+        a += GEMM_MR;
+        b += NR;
+    }
+
+    for(size_t i = 0; i < mr; i++)
+    {
+        T *c = C + i * ldc;
+
+        if(beta == 0)
+        {
+            for(size_t j = 0; j < nr; j++)
+                c[j] = alpha * ab[i * NR + j];
+        }
+        else
+        {
+            for(size_t j = 0; j < nr; j++)
+                c[j] = beta * c[j] + alpha * ab[i * NR + j];
+        }
+    }
+}
+
+template<class T>
+void gemm(size_t m, size_t n, size_t k, double alpha,
+          const T *A, size_t lda, const T *B, size_t ldb,
+          double beta, T *C, size_t ldc)
+{
+    gemm(NO_TRANS, NO_TRANS, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+template<class T>
+void gemm(Op opA, Op opB, size_t m, size_t n, size_t k, double alpha,
+          const T *A, size_t lda, const T *B, size_t ldb,
+          double beta, T *C, size_t ldc)
+{
+    if(m == 0 || n == 0)
+        return;
+
+    if(k == 0 || alpha == 0.0)
+    {
+        for(size_t i = 0; i < m; i++)
+        {
+            for(size_t j = 0; j < n; j++)
+                C[i * ldc + j] = beta == 0.0 ? T(0) : T(beta * C[i * ldc + j]);
+        }
+
+        return;
+    }
+
+    const size_t NR = gemmNr<T>();
+    size_t mcMax = m < GEMM_MC ? m : GEMM_MC;
+    size_t ncMax = n < GEMM_NC ? n : GEMM_NC;
+    size_t kcMax = k < GEMM_KC ? k : GEMM_KC;
+
+    T *packedA = static_cast<T *>(packBufferA.reserve(((mcMax + GEMM_MR - 1) / GEMM_MR) * GEMM_MR * kcMax * sizeof(T)));
+    T *packedB = static_cast<T *>(packBufferB.reserve(((ncMax + NR - 1) / NR) * NR * kcMax * sizeof(T)));
+
+    for(size_t jc = 0; jc < n; jc += GEMM_NC)
+    {
+        size_t nc = n - jc < GEMM_NC ? n - jc : GEMM_NC;
+
+        for(size_t pc = 0; pc < k; pc += GEMM_KC)
+        {
+            size_t kc = k - pc < GEMM_KC ? k - pc : GEMM_KC;
+            T betaBlock = pc == 0 ? T(beta) : T(1);
+
+            packB(opB, kc, nc, opB == NO_TRANS ? B + pc * ldb + jc : B + jc * ldb + pc, ldb, packedB);
+
+            for(size_t ic = 0; ic < m; ic += GEMM_MC)
+            {
+                size_t mc = m - ic < GEMM_MC ? m - ic : GEMM_MC;
+
+                packA(opA, mc, kc, opA == NO_TRANS ? A + ic * lda + pc : A + pc * lda + ic, lda, packedA);
+
+                for(size_t jr = 0; jr < nc; jr += NR)
+                {
+                    size_t nr = nc - jr < NR ? nc - jr : NR;
+
+                    for(size_t ir = 0; ir < mc; ir += GEMM_MR)
+                    {
+                        size_t mr = mc - ir < GEMM_MR ? mc - ir : GEMM_MR;
+
+                        microKernel(kc, packedA + ir * kc, packedB + jr * kc,
+                                    T(alpha), betaBlock,
+                                    C + (ic + ir) * ldc + jc + jr, ldc, mr, nr);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<class T>
+void gemmParallel(ThreadPool *pool, size_t m, size_t n, size_t k, double alpha,
+                  const T *A, size_t lda, const T *B, size_t ldb,
+                  double beta, T *C, size_t ldc)
+{
+    gemmParallel(pool, NO_TRANS, NO_TRANS, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+template<class T>
+void gemmParallel(ThreadPool *pool, Op opA, Op opB, size_t m, size_t n, size_t k, double alpha,
+                  const T *A, size_t lda, const T *B, size_t ldb,
+                  double beta, T *C, size_t ldc)
+{
+    if(m * n * k < GEMM_PARALLEL_MIN)
+    {
+        gemm(opA, opB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+        return;
+    }
+
+    if(pool == nullptr)
+        pool = &ThreadPool::shared();
+
+    size_t threads = pool->size();
+
+    if(threads <= 1)
+    {
+        gemm(opA, opB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+        return;
+    }
+
+    // Dlazdice zacinaji na velikosti bloku MC x 2*MC a puli se, dokud
+    // jich neni alespon dvakrat vic nez vlaken (kvuli vyvazeni zateze)
+    size_t tileM = GEMM_MC;
+    size_t tileN = 2 * GEMM_MC;
+
+    while((m + tileM - 1) / tileM * ((n + tileN - 1) / tileN) < 2 * threads)
+    {
+        if(tileN >= tileM && tileN > 4 * GEMM_NR)
+            tileN /= 2;
+        else if(tileM > 4 * GEMM_MR)
+            tileM /= 2;
+        else
+            break;
+    }
+
+    size_t tilesM = (m + tileM - 1) / tileM;
+    size_t tilesN = (n + tileN - 1) / tileN;
+
+    pool->parallelFor(tilesM * tilesN, [&](size_t tile) {
+        size_t i = tile / tilesN * tileM;
+        size_t j = tile % tilesN * tileN;
+        size_t mt = m - i < tileM ? m - i : tileM;
+        size_t nt = n - j < tileN ? n - j : tileN;
+
+        gemm(opA, opB, mt, nt, k, alpha,
+             opA == NO_TRANS ? A + i * lda : A + i, lda,
+             opB == NO_TRANS ? B + j : B + j * ldb, ldb,
+             beta, C + i * ldc + j, ldc);
+    });
+}
+
+/**
+ * y[i] = alpha * (A[i] . x) + beta * y[i] pro radky i0 az i1
+ */
+static void gemvRows(size_t i0, size_t i1, size_t n, double alpha, const double *A, size_t lda,
+                     const double *x, double beta, double *y)
+{
+    const ElementwiseKernels &kernels = elementwise();
+
+    for(size_t i = i0; i < i1; i++)
+    {
+        double d = alpha * kernels.dot(n, A + i * lda, x);
+
+        y[i] = beta == 0.0 ? d : d + beta * y[i];
+    }
+}
+
+/**
+ * y = alpha * A^T x + beta * y pro radky i0 az i1 a sloupce j0 az j1,
+ * y ukazuje na prvek odpovidajici sloupci j0
+ */
+static void gemvTransBlock(size_t i0, size_t i1, size_t j0, size_t j1, double alpha,
+                           const double *A, size_t lda, const double *x, double beta, double *y)
+{
+    const ElementwiseKernels &kernels = elementwise();
+    size_t len = j1 - j0;
+
+    if(beta == 0.0)
+        std::fill(y, y + len, 0.0);
+    else if(beta != 1.0)
+        kernels.scale(len, beta, y, y);
+
+    for(size_t i = i0; i < i1; i++)
+        kernels.fma(len, alpha * x[i], A + i * lda + j0, y, y);
+}
+
+void gemv(ThreadPool *pool, Op op, size_t m, size_t n, double alpha, const double *A, size_t lda,
+          const double *x, double beta, double *y)
+{
+    size_t threads = 1;
+
+    if(m * n >= GEMV_PARALLEL_MIN)
+    {
+        if(pool == nullptr)
+            pool = &ThreadPool::shared();
+
+        threads = pool->size();
+    }
+
+    if(op == NO_TRANS)
+    {
+        size_t parts = std::min(threads, m / GEMV_MIN_BLOCK);
+
+        if(parts <= 1)
+        {
+            gemvRows(0, m, n, alpha, A, lda, x, beta, y);
+            return;
+        }
+
+        pool->parallelFor(parts, [&](size_t t) {
+            gemvRows(m * t / parts, m * (t + 1) / parts, n, alpha, A, lda, x, beta, y);
+        });
+
+        return;
+    }
+
+    size_t colParts = std::min(threads, n / GEMV_MIN_BLOCK);
+    size_t rowParts = std::min(threads, m / GEMV_MIN_BLOCK);
+
+    if(threads > 1 && colParts == threads)
+    {
+        // Kazda uloha zapisuje vlastni useky y, hranice na celych radcich
+        // cache (MATRIX_ALIGN_ELEMS), aby se zapisy vlaken neprekryvaly
+        pool->parallelFor(colParts, [&](size_t t) {
+            size_t j0 = t == 0 ? 0 : n * t / colParts / MATRIX_ALIGN_ELEMS * MATRIX_ALIGN_ELEMS;
+            size_t j1 = t + 1 == colParts ? n : n * (t + 1) / colParts / MATRIX_ALIGN_ELEMS * MATRIX_ALIGN_ELEMS;
+
+            gemvTransBlock(0, m, j0, j1, alpha, A, lda, x, beta, y + j0);
+        });
+    }
+    else if(threads > 1 && rowParts > 1)
+    {
+        // Uzka vysoka matice: dilci soucty po blocich radku, secteny na konci
+        std::vector<double> partial((rowParts - 1) * n);
+
+        pool->parallelFor(rowParts, [&](size_t t) {
+            gemvTransBlock(m * t / rowParts, m * (t + 1) / rowParts, 0, n, alpha, A, lda, x,
+                           t == 0 ? beta : 0.0, t == 0 ? y : partial.data() + (t - 1) * n);
+        });
+
+        const ElementwiseKernels &kernels = elementwise();
+
+        for(size_t t = 1; t < rowParts; t++)
+            kernels.add(n, y, partial.data() + (t - 1) * n, y);
+    }
+    else
+    {
+        gemvTransBlock(0, m, 0, n, alpha, A, lda, x, beta, y);
+    }
+}
+
+double dot(ThreadPool *pool, size_t n, const double *x, const double *y)
+{
+    const ElementwiseKernels &kernels = elementwise();
+    size_t parts = 1;
+
+    if(n >= DOT_PARALLEL_MIN)
+    {
+        if(pool == nullptr)
+            pool = &ThreadPool::shared();
+
+        parts = std::min(pool->size(), n / DOT_MIN_BLOCK);
+    }
+
+    if(parts <= 1)
+        return kernels.dot(n, x, y);
+
+    std::vector<double> partial(parts);
+
+    pool->parallelFor(parts, [&](size_t t) {
+        size_t begin = n * t / parts, end = n * (t + 1) / parts;
+
+        partial[t] = kernels.dot(end - begin, x + begin, y + begin);
+    });
+
+    double sum = 0;
+
+    for(size_t t = 0; t < parts; t++)
+        sum += partial[t];
+
+    return sum;
+}
+
+void transpose(size_t m, size_t n, const double *A, size_t lda, double *B, size_t ldb)
+{
+    if(m <= TRANSPOSE_BLOCK && n <= TRANSPOSE_BLOCK)
+    {
+        for(size_t i = 0; i < m; i++)
+        {
+            for(size_t j = 0; j < n; j++)
+                B[j * ldb + i] = A[i * lda + j];
+        }
+
+        return;
+    }
+
+    // Deli se vzdy delsi rozmer, bloky tak zustavaji priblizne ctvercove
+    if(m >= n)
+    {
+        size_t h = m / 2;
+
+        transpose(h, n, A, lda, B, ldb);
+        transpose(m - h, n, A + h * lda, lda, B + h, ldb);
+    }
+    else
+    {
+        size_t h = n / 2;
+
+        transpose(m, h, A, lda, B, ldb);
+        transpose(m, n - h, A + h, lda, B + h * ldb, ldb);
+    }
+}
+
+/**
+ * Prohodi prvky A[i][j] a B[j][i], A je m x n, B je n x m (mimodiagonalni
+ * bloky ctvercove matice)
+ */
+static void transposeSwap(size_t m, size_t n, double *A, size_t lda, double *B, size_t ldb)
+{
+    if(m <= TRANSPOSE_BLOCK && n <= TRANSPOSE_BLOCK)
+    {
+        for(size_t i = 0; i < m; i++)
+        {
+            for(size_t j = 0; j < n; j++)
+            {
+                double tmp = A[i * lda + j];
+                A[i * lda + j] = B[j * ldb + i];
+                B[j * ldb + i] = tmp;
+            }
+        }
+
+        return;
+    }
+
+    if(m >= n)
+    {
+        size_t h = m / 2;
+
+        transposeSwap(h, n, A, lda, B, ldb);
+        transposeSwap(m - h, n, A + h * lda, lda, B + h, ldb);
+    }
+    else
+    {
+        size_t h = n / 2;
+
+        transposeSwap(m, h, A, lda, B, ldb);
+        transposeSwap(m, n - h, A + h, lda, B + h * ldb, ldb);
+    }
+}
+
+void transposeInPlace(size_t n, double *A, size_t lda)
+{
+    if(n <= TRANSPOSE_BLOCK)
+    {
+        for(size_t i = 0; i < n; i++)
+        {
+            for(size_t j = i + 1; j < n; j++)
+            {
+                double tmp = A[i * lda + j];
+                A[i * lda + j] = A[j * lda + i];
+                A[j * lda + i] = tmp;
+            }
+        }
+
+        return;
+    }
+
+    size_t h = n / 2;
+
+    transposeInPlace(h, A, lda);
+    transposeInPlace(n - h, A + h * lda + h, lda);
+    transposeSwap(h, n - h, A + h, lda, A + h * lda, lda);
+}
+
+/**
+ * y += alpha * x nad radkem matice. Pro double se pouzije vybrane SIMD
+ * jadro, smycku pro float vektorizuje prekladac.
+ */
+static void axpy(size_t n, double alpha, const double *x, double *y)
+{
+    elementwise().fma(n, alpha, x, y, y);
+}
+
+static void axpy(size_t n, float alpha, const float *x, float *y)
+{
+    for(size_t i = 0; i < n; i++)
+        y[i] += alpha * x[i];
+}
+
+/**
+ * x *= alpha nad radkem matice
+ */
+static void scal(size_t n, double alpha, double *x)
+{
+    elementwise().scale(n, alpha, x, x);
+}
+
+static void scal(size_t n, float alpha, float *x)
+{
+    for(size_t i = 0; i < n; i++)
+        x[i] *= alpha;
+}
+
+/**
+ * Nebloky LU rozklad panelu: sloupce [k, k + nb) radku [k, m). Radky se
+ * prohazuji v prvnich n sloupcich (u getrf cele, vcetne jiz rozlozene
+ * casti vlevo i zbytku matice vpravo), aktualizace se ale provadi jen
+ * uvnitr panelu.
+ */
+template<class T>
+static bool getrfPanel(size_t m, size_t n, size_t k, size_t nb, T *A, size_t lda,
+                       size_t *pivots, double tolerance)
+{
+    for(size_t j = k; j < k + nb; j++)
+    {
+        size_t pivot = j;
+        T pivotAbs = std::fabs(A[j * lda + j]);
+
+        for(size_t i = j + 1; i < m; i++)
+        {
+            T value = std::fabs(A[i * lda + j]);
+
+            if(value > pivotAbs)
+            {
+                pivot = i;
+                pivotAbs = value;
+            }
+        }
+
+        pivots[j] = pivot;
+
+        if(!(pivotAbs > tolerance))
+            return false;
+
+        if(pivot != j)
+        {
+            T *rowJ = A + j * lda;
+            T *rowP = A + pivot * lda;
+
+            for(size_t c = 0; c < n; c++)
+            {
+                T tmp = rowJ[c];
+                rowJ[c] = rowP[c];
+                rowP[c] = tmp;
+            }
+        }
+
+        // Radky jsou souvisle, aktualizace panelu je proto rada operaci
+        // radek_i -= l_ij * radek_j nad souvislymi poli
+        const T *rowJ = A + j * lda + j + 1;
+        T inverse = T(1) / A[j * lda + j];
+        size_t width = k + nb - j - 1;
+
+        for(size_t i = j + 1; i < m; i++)
+        {
+            T *rowI = A + i * lda;
+            T l = rowI[j] * inverse;
+
+            rowI[j] = l;
+            axpy(width, -l, rowJ, rowI + j + 1);
+        }
+    }
+
+    return true;
+}
+
+template<class T>
+bool getrf(size_t n, T *A, size_t lda, size_t *pivots, double tolerance)
+{
+    for(size_t k = 0; k < n; k += LU_NB)
+    {
+        size_t nb = n - k < LU_NB ? n - k : LU_NB;
+        size_t rest = n - k - nb;
+
+        if(!getrfPanel(n, n, k, nb, A, lda, pivots, tolerance))
+            return false;
+
+        if(rest == 0)
+            break;
+
+        // U12 = L11^-1 * A12
+        trsmLowerUnit(nb, rest, A + k * lda + k, lda, A + k * lda + k + nb, lda);
+
+        // A22 -= L21 * U12, dominantni cast prace, bezi paralelne
+        gemmParallel(nullptr, rest, rest, nb, -1.0,
+                     A + (k + nb) * lda + k, lda, A + k * lda + k + nb, lda,
+                     1.0, A + (k + nb) * lda + k + nb, lda);
+    }
+
+    return true;
+}
+
+template<class T>
+void trsmLowerUnit(size_t n, size_t nrhs, const T *L, size_t lda, T *B, size_t ldb)
+{
+    for(size_t ib = 0; ib < n; ib += LU_NB)
+    {
+        size_t nb = n - ib < LU_NB ? n - ib : LU_NB;
+
+        if(ib > 0)
+            gemm(nb, nrhs, ib, -1.0, L + ib * lda, lda, B, ldb, 1.0, B + ib * ldb, ldb);
+
+        for(size_t i = ib + 1; i < ib + nb; i++)
+        {
+            for(size_t j = ib; j < i; j++)
+                axpy(nrhs, -L[i * lda + j], B + j * ldb, B + i * ldb);
+        }
+    }
+}
+
+template<class T>
+void trsmUpper(size_t n, size_t nrhs, const T *U, size_t lda, T *B, size_t ldb)
+{
+    for(size_t ie = n; ie > 0; )
+    {
+        size_t nb = ie < LU_NB ? ie : LU_NB;
+        size_t ib = ie - nb;
+
+        if(ie < n)
+            gemm(nb, nrhs, n - ie, -1.0, U + ib * lda + ie, lda, B + ie * ldb, ldb, 1.0, B + ib * ldb, ldb);
+
+        for(size_t i = ie; i-- > ib; )
+        {
+            for(size_t j = i + 1; j < ie; j++)
+                axpy(nrhs, -U[i * lda + j], B + j * ldb, B + i * ldb);
+
+            scal(nrhs, T(1) / U[i * lda + i], B + i * ldb);
+        }
+
+        ie = ib;
+    }
+}
+
+void getrsTransposed(size_t n, const double *LU, size_t lda, const size_t *pivots, double *b)
+{
+    const ElementwiseKernels &kernels = elementwise();
+
+    // A^T = U^T L^T P, nejprve U^T y = b (dopredne, po radcich U)
+    for(size_t j = 0; j < n; j++)
+    {
+        const double *row = LU + j * lda;
+
+        b[j] /= row[j];
+        kernels.fma(n - j - 1, -b[j], row + j + 1, b + j + 1, b + j + 1);
+    }
+
+    // L^T z = y (zpetne, po radcich L)
+    for(size_t j = n; j-- > 1; )
+        kernels.fma(j, -b[j], LU + j * lda, b, b);
+
+    // x = P^T z
+    for(size_t k = n; k-- > 0; )
+    {
+        if(pivots[k] != k)
+        {
+            double tmp = b[k];
+            b[k] = b[pivots[k]];
+            b[pivots[k]] = tmp;
+        }
+    }
+}
+
+void getrsBatch(ThreadPool *pool, size_t n, size_t nrhs, const double *LU, size_t lda,
+                const size_t *pivots, double *B, size_t ldb)
+{
+    for(size_t k = 0; k < n; k++)
+    {
+        if(pivots[k] != k)
+        {
+            double *rowK = B + k * ldb;
+            double *rowP = B + pivots[k] * ldb;
+
+            for(size_t c = 0; c < nrhs; c++)
+            {
+                double tmp = rowK[c];
+                rowK[c] = rowP[c];
+                rowP[c] = tmp;
+            }
+        }
+    }
+
+    // Sloupce prave strany jsou na sobe nezavisle, kazde vlakno resi
+    // vlastni svisly pruh B
+    size_t strips = 1;
+
+    if(n * n * nrhs >= GEMM_PARALLEL_MIN)
+    {
+        if(pool == nullptr)
+            pool = &ThreadPool::shared();
+
+        strips = (nrhs + LU_NB - 1) / LU_NB;
+        if(strips > pool->size())
+            strips = pool->size();
+    }
+
+    if(strips <= 1)
+    {
+        trsmLowerUnit(n, nrhs, LU, lda, B, ldb);
+        trsmUpper(n, nrhs, LU, lda, B, ldb);
+        return;
+    }
+
+    size_t width = (nrhs + strips - 1) / strips;
+
+    pool->parallelFor(strips, [&](size_t strip) {
+        size_t c = strip * width;
+
+        if(c >= nrhs)
+            return;
+
+        size_t w = nrhs - c < width ? nrhs - c : width;
+
+        trsmLowerUnit(n, w, LU, lda, B + c, ldb);
+        trsmUpper(n, w, LU, lda, B + c, ldb);
+    });
+}
+
+template<class T>
+void getrs(size_t n, const T *LU, size_t lda, const size_t *pivots, T *b)
+{
+    for(size_t k = 0; k < n; k++)
+    {
+        if(pivots[k] != k)
+        {
+            T tmp = b[k];
+            b[k] = b[pivots[k]];
+            b[pivots[k]] = tmp;
+        }
+    }
+
+    for(size_t i = 1; i < n; i++)
+    {
+        const T *row = LU + i * lda;
+        T sum = b[i];
+
+        for(size_t j = 0; j < i; j++)
+            sum -= row[j] * b[j];
+
+        b[i] = sum;
+    }
+
+    for(size_t i = n; i-- > 0; )
+    {
+        const T *row = LU + i * lda;
+        T sum = b[i];
+
+        for(size_t j = i + 1; j < n; j++)
+            sum -= row[j] * b[j];
+
+        b[i] = sum / row[i];
+    }
+}
+
+size_t gesvMixed(size_t n, const double *A, size_t lda, double *b)
+{
+    // Kopie matice ve float, zacatek i radky zarovnane stejne jako u matic
+    // double (uloziste PackBuffer se uvolni i pri predcasnem navratu)
+    const size_t align = MATRIX_ALIGN_BYTES / sizeof(float);
+    size_t ldf = (n + align - 1) / align * align;
+    PackBuffer storage;
+    float *low = static_cast<float *>(storage.reserve(n * ldf * sizeof(float)));
+    std::vector<size_t> pivots(n);
+    double maxAbs = 0;
+    double normA = 0;
+
+    for(size_t i = 0; i < n; i++)
+    {
+        double rowSum = 0;
+
+        for(size_t j = 0; j < n; j++)
+        {
+            double value = std::fabs(A[i * lda + j]);
+
+            low[i * ldf + j] = static_cast<float>(A[i * lda + j]);
+            maxAbs = std::fmax(maxAbs, value);
+            rowSum += value;
+        }
+
+        normA = std::fmax(normA, rowSum);
+    }
+
+    // Prvky mimo rozsah float by se prevedly na nekonecno
+    if(!(maxAbs <= std::numeric_limits<float>::max()))
+        return 0;
+
+    if(!getrf(n, low, ldf, pivots.data(), maxAbs * n * std::numeric_limits<float>::epsilon()))
+        return 0;
+
+    std::vector<double> x(n, 0.0), r(b, b + n);
+    std::vector<float> d(n);
+    double limit = normA * std::numeric_limits<double>::epsilon() * std::sqrt(static_cast<double>(n));
+
+    for(size_t iteration = 1; iteration <= MIXED_MAX_ITERATIONS; iteration++)
+    {
+        // Oprava A d = r v jednoduche presnosti, prvni krok je primo reseni
+        for(size_t i = 0; i < n; i++)
+            d[i] = static_cast<float>(r[i]);
+
+        getrs(n, low, ldf, pivots.data(), d.data());
+
+        double normX = 0;
+
+        for(size_t i = 0; i < n; i++)
+        {
+            x[i] += d[i];
+            normX = std::fmax(normX, std::fabs(x[i]));
+        }
+
+        // Reziduum r = b - A x v dvojite presnosti
+        std::copy(b, b + n, r.begin());
+        gemv(nullptr, NO_TRANS, n, n, -1.0, A, lda, x.data(), 1.0, r.data());
+
+        double normR = 0;
+
+        for(size_t i = 0; i < n; i++)
+            normR = std::fmax(normR, std::fabs(r[i]));
+
+        if(normR <= normX * limit)
+        {
+            std::copy(x.begin(), x.end(), b);
+            return iteration;
+        }
+
+        if(!std::isfinite(normR))
+            break;
+    }
+
+    return 0;
+}
+
+/**
+ * Nebloky Choleskeho rozklad diagonalniho bloku [k, k + nb), predchozi
+ * bloky uz jsou do nej zapocteny aktualizaci zbytku matice
+ */
+static bool potrfPanel(size_t k, size_t nb, double *A, size_t lda)
+{
+    for(size_t j = k; j < k + nb; j++)
+    {
+        const double *rowJ = A + j * lda;
+        double d = rowJ[j];
+
+        for(size_t p = k; p < j; p++)
+            d -= rowJ[p] * rowJ[p];
+
+        if(!(d > 0))
+            return false;
+
+        d = std::sqrt(d);
+        A[j * lda + j] = d;
+
+        for(size_t i = j + 1; i < k + nb; i++)
+        {
+            double *rowI = A + i * lda;
+            double sum = rowI[j];
+
+            for(size_t p = k; p < j; p++)
+                sum -= rowI[p] * rowJ[p];
+
+            rowI[j] = sum / d;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Blokovy Choleskeho rozklad, pri pool == nullptr cely v jednom vlakne
+ */
+static bool potrfBlocked(size_t n, double *A, size_t lda, ThreadPool *pool)
+{
+    for(size_t k = 0; k < n; k += LU_NB)
+    {
+        size_t nb = n - k < LU_NB ? n - k : LU_NB;
+        size_t rest = n - k - nb;
+
+        if(!potrfPanel(k, nb, A, lda))
+            return false;
+
+        if(rest == 0)
+            break;
+
+        const double *L11 = A + k * lda + k;
+        size_t strips = (rest + LU_NB - 1) / LU_NB;
+
+        // Kazda uloha zpracuje pruh nejvyse LU_NB radku pod panelem
+        std::function<void(size_t)> strip = [&](size_t s) {
+            size_t begin = k + nb + s * LU_NB;
+            size_t end = begin + LU_NB < n ? begin + LU_NB : n;
+
+            // L21 = A21 * L11^-T, kazdy radek je samostatna dopredna substituce
+            for(size_t i = begin; i < end; i++)
+            {
+                double *row = A + i * lda + k;
+
+                for(size_t j = 0; j < nb; j++)
+                {
+                    double sum = row[j];
+
+                    for(size_t p = 0; p < j; p++)
+                        sum -= L11[j * lda + p] * row[p];
+
+                    row[j] = sum / L11[j * lda + j];
+                }
+            }
+        };
+
+        if(pool != nullptr && rest * rest * nb >= GEMM_PARALLEL_MIN)
+            pool->parallelFor(strips, strip);
+        else
+        {
+            for(size_t s = 0; s < strips; s++)
+                strip(s);
+        }
+
+        // A22 -= L21 * L21^T, pouze dolni trojuhelnik (pruh s radky
+        // [begin, end) potrebuje sloupce jen do end)
+        strip = [&](size_t s) {
+            size_t begin = k + nb + s * LU_NB;
+            size_t end = begin + LU_NB < n ? begin + LU_NB : n;
+
+            gemm(NO_TRANS, TRANS, end - begin, end - (k + nb), nb, -1.0, A + begin * lda + k, lda,
+                 A + (k + nb) * lda + k, lda, 1.0, A + begin * lda + k + nb, lda);
+        };
+
+        if(pool != nullptr && rest * rest * nb >= GEMM_PARALLEL_MIN)
+            pool->parallelFor(strips, strip);
+        else
+        {
+            for(size_t s = 0; s < strips; s++)
+                strip(s);
+        }
+    }
+
+    return true;
+}
+
+bool potrf(size_t n, double *A, size_t lda)
+{
+    return potrfBlocked(n, A, lda, &ThreadPool::shared());
+}
+
+bool potrfTile(size_t n, double *A, size_t lda)
+{
+    return potrfBlocked(n, A, lda, nullptr);
+}
+
+bool getrfTile(size_t m, size_t n, double *A, size_t lda, size_t *pivots, double tolerance)
+{
+    for(size_t k = 0; k < n; k += LU_NB)
+    {
+        size_t nb = n - k < LU_NB ? n - k : LU_NB;
+        size_t rest = n - k - nb;
+
+        if(!getrfPanel(m, n, k, nb, A, lda, pivots, tolerance))
+            return false;
+
+        if(rest == 0)
+            break;
+
+        trsmLowerUnit(nb, rest, A + k * lda + k, lda, A + k * lda + k + nb, lda);
+
+        gemm(m - k - nb, rest, nb, -1.0, A + (k + nb) * lda + k, lda, A + k * lda + k + nb, lda,
+             1.0, A + (k + nb) * lda + k + nb, lda);
+    }
+
+    return true;
+}
+
+void laswp(size_t n, double *A, size_t lda, size_t k1, size_t k2, const size_t *pivots)
+{
+    for(size_t k = k1; k < k2; k++)
+    {
+        if(pivots[k] != k)
+            std::swap_ranges(A + k * lda, A + k * lda + n, A + pivots[k] * lda);
+    }
+}
+
+void trsmRightLowerTransposed(size_t m, size_t n, const double *L, size_t lda, double *B, size_t ldb)
+{
+    for(size_t jb = 0; jb < n; jb += LU_NB)
+    {
+        size_t nb = n - jb < LU_NB ? n - jb : LU_NB;
+
+        // Sloupce [jb, jb + nb) bez prispevku uz vyresenych sloupcu X
+        if(jb > 0)
+            gemm(NO_TRANS, TRANS, m, nb, jb, -1.0, B, ldb, L + jb * lda, lda, 1.0, B + jb, ldb);
+
+        for(size_t i = 0; i < m; i++)
+        {
+            double *row = B + i * ldb;
+
+            for(size_t j = jb; j < jb + nb; j++)
+            {
+                const double *rowL = L + j * lda;
+                double sum = row[j];
+
+                for(size_t p = jb; p < j; p++)
+                    sum -= rowL[p] * row[p];
+
+                row[j] = sum / rowL[j];
+            }
+        }
+    }
+}
+
+void trsmLower(size_t n, size_t nrhs, const double *L, size_t lda, double *B, size_t ldb)
+{
+    const ElementwiseKernels &kernels = elementwise();
+
+    for(size_t ib = 0; ib < n; ib += LU_NB)
+    {
+        size_t nb = n - ib < LU_NB ? n - ib : LU_NB;
+
+        if(ib > 0)
+            gemm(nb, nrhs, ib, -1.0, L + ib * lda, lda, B, ldb, 1.0, B + ib * ldb, ldb);
+
+        for(size_t i = ib; i < ib + nb; i++)
+        {
+            for(size_t j = ib; j < i; j++)
+                kernels.fma(nrhs, -L[i * lda + j], B + j * ldb, B + i * ldb, B + i * ldb);
+
+            kernels.scale(nrhs, 1.0 / L[i * lda + i], B + i * ldb, B + i * ldb);
+        }
+    }
+}
+
+void trsmLowerTransposed(size_t n, size_t nrhs, const double *L, size_t lda, double *B, size_t ldb)
+{
+    const ElementwiseKernels &kernels = elementwise();
+
+    for(size_t ie = n; ie > 0; )
+    {
+        size_t nb = ie < LU_NB ? ie : LU_NB;
+        size_t ib = ie - nb;
+
+        // Blok L^T vpravo od diagonaly je transponovany blok L pod ni
+        if(ie < n)
+            gemm(TRANS, NO_TRANS, nb, nrhs, n - ie, -1.0, L + ie * lda + ib, lda,
+                 B + ie * ldb, ldb, 1.0, B + ib * ldb, ldb);
+
+        for(size_t i = ie; i-- > ib; )
+        {
+            kernels.scale(nrhs, 1.0 / L[i * lda + i], B + i * ldb, B + i * ldb);
+
+            for(size_t j = ib; j < i; j++)
+                kernels.fma(nrhs, -L[i * lda + j], B + i * ldb, B + j * ldb, B + j * ldb);
+        }
+
+        ie = ib;
+    }
+}
+
+void potrs(size_t n, const double *L, size_t lda, double *b)
+{
+    const ElementwiseKernels &kernels = elementwise();
+
+    for(size_t i = 0; i < n; i++)
+    {
+        const double *row = L + i * lda;
+        double sum = b[i];
+
+        for(size_t j = 0; j < i; j++)
+            sum -= row[j] * b[j];
+
+        b[i] = sum / row[i];
+    }
+
+    // L^T x = y (zpetne, po radcich L)
+    for(size_t i = n; i-- > 0; )
+    {
+        b[i] /= L[i * lda + i];
+        kernels.fma(i, -b[i], L + i * lda, b, b);
+    }
+}
+
+void potrsBatch(ThreadPool *pool, size_t n, size_t nrhs, const double *L, size_t lda,
+                double *B, size_t ldb)
+{
+    size_t strips = 1;
+
+    if(n * n * nrhs >= GEMM_PARALLEL_MIN)
+    {
+        if(pool == nullptr)
+            pool = &ThreadPool::shared();
+
+        strips = (nrhs + LU_NB - 1) / LU_NB;
+        if(strips > pool->size())
+            strips = pool->size();
+    }
+
+    if(strips <= 1)
+    {
+        trsmLower(n, nrhs, L, lda, B, ldb);
+        trsmLowerTransposed(n, nrhs, L, lda, B, ldb);
+        return;
+    }
+
+    size_t width = (nrhs + strips - 1) / strips;
+
+    pool->parallelFor(strips, [&](size_t strip) {
+        size_t c = strip * width;
+
+        if(c >= nrhs)
+            return;
+
+        size_t w = nrhs - c < width ? nrhs - c : width;
+
+        trsmLower(n, w, L, lda, B + c, ldb);
+        trsmLowerTransposed(n, w, L, lda, B + c, ldb);
+    });
+}
+
+/**
+ * Nebloky QR rozklad panelu m x nb, reflektory se aplikuji jen uvnitr
+ * panelu (po radcich, aby se A cetla souvisle)
+ */
+static void geqr2(size_t m, size_t nb, double *A, size_t lda, double *tau)
+{
+    const ElementwiseKernels &kernels = elementwise();
+    std::vector<double> w(nb);
+
+    for(size_t j = 0; j < nb && j < m; j++)
+    {
+        double alpha = A[j * lda + j];
+        double xnorm = 0;
+
+        for(size_t i = j + 1; i < m; i++)
+            xnorm = std::hypot(xnorm, A[i * lda + j]);
+
+        if(xnorm == 0)
+        {
+            tau[j] = 0;
+            continue;
+        }
+
+        // H (alpha, x)^T = (beta, 0)^T, znamenko beta brani ztrate presnosti
+        double beta = -std::copysign(std::hypot(alpha, xnorm), alpha);
+        double scale = 1.0 / (alpha - beta);
+
+        tau[j] = (beta - alpha) / beta;
+        A[j * lda + j] = beta;
+
+        for(size_t i = j + 1; i < m; i++)
+            A[i * lda + j] *= scale;
+
+        // w = v^T A(j:m, j+1:nb), A -= tau v w
+        size_t rest = nb - j - 1;
+
+        if(rest == 0)
+            continue;
+
+        std::copy(A + j * lda + j + 1, A + j * lda + nb, w.begin());
+
+        for(size_t i = j + 1; i < m; i++)
+            kernels.fma(rest, A[i * lda + j], A + i * lda + j + 1, w.data(), w.data());
+
+        kernels.fma(rest, -tau[j], w.data(), A + j * lda + j + 1, A + j * lda + j + 1);
+
+        for(size_t i = j + 1; i < m; i++)
+            kernels.fma(rest, -tau[j] * A[i * lda + j], w.data(), A + i * lda + j + 1, A + i * lda + j + 1);
+    }
+}
+
+/**
+ * Horni trojuhelnikova T (nb x nb) kompaktniho WY tvaru H_0 ... H_{nb-1}
+ * = I - V T V^T z reflektoru ulozenych pod diagonalou V (m x nb):
+ * T(0:j, j) = -tau_j T(0:j, 0:j) V(:, 0:j)^T v_j
+ */
+static void larft(size_t m, size_t nb, const double *V, size_t ldv, const double *tau,
+                  double *T, size_t ldt)
+{
+    const ElementwiseKernels &kernels = elementwise();
+    std::vector<double> gram(nb * nb, 0.0);
+
+    // gram[j nb + p] = v_p^T v_j pro p < j, V se cte po radcich na miste:
+    // jednotkovy prvek v_j lezi v radku j, prvky nad nim jsou nulove
+    for(size_t i = 1; i < m; i++)
+    {
+        const double *row = V + i * ldv;
+        size_t lower = i < nb ? i : nb;
+
+        for(size_t j = 1; j < lower; j++)
+            kernels.fma(j, row[j], row, gram.data() + j * nb, gram.data() + j * nb);
+
+        if(i < nb)
+            kernels.add(i, gram.data() + i * nb, row, gram.data() + i * nb);
+    }
+
+    for(size_t j = 0; j < nb; j++)
+    {
+        T[j * ldt + j] = tau[j];
+
+        for(size_t i = 0; i < j; i++)
+        {
+            double sum = 0;
+
+            for(size_t p = i; p < j; p++)
+                sum += T[i * ldt + p] * gram[j * nb + p];
+
+            T[i * ldt + j] = -tau[j] * sum;
+        }
+    }
+}
+
+/**
+ * C = (I - V T V^T)^T C pro blok nb reflektoru ulozenych pod diagonalou V
+ * (m x nb, m >= nb), tj. C = H_{nb-1} ... H_0 C. V se pouziva na miste:
+ * horni blok nb x nb (jednotkovy dolni trojuhelnik) se nasobi po radcich,
+ * zbytek V pres gemm.
+ */
+static void larfb(size_t m, size_t nb, const double *V, size_t ldv, const double *T, size_t ldt,
+                  size_t nc, double *C, size_t ldc)
+{
+    const ElementwiseKernels &kernels = elementwise();
+    std::vector<double> w(nb * nc), row(nc);
+
+    // W = V_1^T C_1 + V_2^T C_2
+    std::copy(C, C + nc, w.begin());
+
+    for(size_t i = 1; i < nb; i++)
+    {
+        std::copy(C + i * ldc, C + i * ldc + nc, w.begin() + i * nc);
+
+        for(size_t j = 0; j < i; j++)
+            kernels.fma(nc, V[i * ldv + j], C + i * ldc, w.data() + j * nc, w.data() + j * nc);
+    }
+
+    if(m > nb)
+        gemmParallel(nullptr, TRANS, NO_TRANS, nb, nc, m - nb, 1.0, V + nb * ldv, ldv,
+                     C + nb * ldc, ldc, 1.0, w.data(), nc);
+
+    // W = T^T W
+    for(size_t i = nb; i-- > 0; )
+    {
+        kernels.scale(nc, T[i * ldt + i], w.data() + i * nc, row.data());
+
+        for(size_t p = 0; p < i; p++)
+            kernels.fma(nc, T[p * ldt + i], w.data() + p * nc, row.data(), row.data());
+
+        std::copy(row.begin(), row.end(), w.begin() + i * nc);
+    }
+
+    // C_2 -= V_2 W, C_1 -= V_1 W
+    if(m > nb)
+        gemmParallel(nullptr, m - nb, nc, nb, -1.0, V + nb * ldv, ldv, w.data(), nc,
+                     1.0, C + nb * ldc, ldc);
+
+    for(size_t i = 0; i < nb; i++)
+    {
+        double *out = C + i * ldc;
+
+        kernels.fma(nc, -1.0, w.data() + i * nc, out, out);
+
+        for(size_t j = 0; j < i; j++)
+            kernels.fma(nc, -V[i * ldv + j], w.data() + j * nc, out, out);
+    }
+}
+
+void geqrf(size_t m, size_t n, double *A, size_t lda, double *tau, double *T)
+{
+    for(size_t k = 0; k < n; k += QR_NB)
+    {
+        size_t nb = n - k < QR_NB ? n - k : QR_NB;
+
+        geqr2(m - k, nb, A + k * lda + k, lda, tau + k);
+        larft(m - k, nb, A + k * lda + k, lda, tau + k, T + k, n);
+
+        if(k + nb < n)
+            larfb(m - k, nb, A + k * lda + k, lda, T + k, n, n - k - nb, A + k * lda + k + nb, lda);
+    }
+}
+
+void ormqr(size_t m, size_t n, size_t nrhs, const double *QR, size_t lda, const double *T,
+           double *B, size_t ldb)
+{
+    for(size_t k = 0; k < n; k += QR_NB)
+    {
+        size_t nb = n - k < QR_NB ? n - k : QR_NB;
+
+        larfb(m - k, nb, QR + k * lda + k, lda, T + k, n, nrhs, B + k * ldb, ldb);
+    }
+}
+
+bool gels(ThreadPool *pool, size_t m, size_t n, double *A, size_t lda, double *b, double tolerance)
+{
+    if(pool == nullptr)
+        pool = &ThreadPool::shared();
+
+    size_t parts = 1;
+
+    if(m * n >= GEMM_PARALLEL_MIN)
+    {
+        parts = m / (TSQR_MIN_ROWS * n);
+        if(parts > pool->size())
+            parts = pool->size();
+    }
+
+    std::vector<double> tau(n), blockT(QR_NB * n);
+    const double *R = A;
+    size_t ldr = lda;
+    std::vector<double> stacked;
+
+    if(parts < 2)
+    {
+        geqrf(m, n, A, lda, tau.data(), blockT.data());
+        ormqr(m, n, 1, A, lda, blockT.data(), b, 1);
+    }
+    else
+    {
+        // Kazde vlakno rozlozi svuj pruh radku, faktory R_t a (Q_t^T b_t)
+        // se poskladaji pod sebe a rozlozi podruhe
+        std::vector<double> partTau(parts * n), partT(parts * QR_NB * n), c(parts * n);
+
+        stacked.assign(parts * n * n, 0.0);
+
+        pool->parallelFor(parts, [&](size_t t) {
+            size_t begin = m * t / parts;
+            size_t rows = m * (t + 1) / parts - begin;
+            double *block = A + begin * lda;
+
+            geqrf(rows, n, block, lda, partTau.data() + t * n, partT.data() + t * QR_NB * n);
+            ormqr(rows, n, 1, block, lda, partT.data() + t * QR_NB * n, b + begin, 1);
+
+            for(size_t i = 0; i < n; i++)
+            {
+                std::copy(block + i * lda + i, block + i * lda + n, stacked.begin() + (t * n + i) * n + i);
+                c[t * n + i] = b[begin + i];
+            }
+        });
+
+        geqrf(parts * n, n, stacked.data(), n, tau.data(), blockT.data());
+        ormqr(parts * n, n, 1, stacked.data(), n, blockT.data(), c.data(), 1);
+
+        std::copy(c.begin(), c.begin() + n, b);
+        R = stacked.data();
+        ldr = n;
+    }
+
+    for(size_t i = 0; i < n; i++)
+    {
+        if(std::fabs(R[i * ldr + i]) <= tolerance)
+            return false;
+    }
+
+    trsmUpper(n, 1, R, ldr, b, 1);
+
+    return true;
+}
+
+/**
+ * out = x + sign * y po radcich bloku rows x cols
+ */
+static void addBlocks(size_t rows, size_t cols, const double *X, size_t ldx, double sign,
+                      const double *Y, size_t ldy, double *out, size_t ldo)
+{
+    const ElementwiseKernels &kernels = elementwise();
+
+    for(size_t r = 0; r < rows; r++)
+    {
+        if(sign > 0)
+            kernels.add(cols, X + r * ldx, Y + r * ldy, out + r * ldo);
+        else
+            kernels.fma(cols, -1.0, Y + r * ldy, X + r * ldx, out + r * ldo);
+    }
+}
+
+void gemmStrassen(ThreadPool *pool, size_t m, size_t n, size_t k, const double *A, size_t lda,
+                  const double *B, size_t ldb, double *C, size_t ldc, size_t threshold)
+{
+    if(m < threshold || n < threshold || k < threshold)
+    {
+        gemmParallel(pool, m, n, k, 1.0, A, lda, B, ldb, 0.0, C, ldc);
+        return;
+    }
+
+    // Rekurze bezi na sudych rozmerech, lichy radek/sloupec se dopocita
+    // klasicky (dynamic peeling)
+    size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+    size_t ls = (k2 + MATRIX_ALIGN_ELEMS - 1) / MATRIX_ALIGN_ELEMS * MATRIX_ALIGN_ELEMS;
+    size_t lt = (n2 + MATRIX_ALIGN_ELEMS - 1) / MATRIX_ALIGN_ELEMS * MATRIX_ALIGN_ELEMS;
+    const double *A11 = A, *A12 = A + k2, *A21 = A + m2 * lda, *A22 = A21 + k2;
+    const double *B11 = B, *B12 = B + n2, *B21 = B + k2 * ldb, *B22 = B21 + n2;
+    double *C11 = C, *C12 = C + n2, *C21 = C + m2 * ldc, *C22 = C21 + n2;
+
+    double *s = alignedAlloc(4 * m2 * ls);
+    double *t = alignedAlloc(4 * k2 * lt);
+    double *x = alignedAlloc(m2 * lt);
+    double *S1 = s, *S2 = s + m2 * ls, *S3 = s + 2 * m2 * ls, *S4 = s + 3 * m2 * ls;
+    double *T1 = t, *T2 = t + k2 * lt, *T3 = t + 2 * k2 * lt, *T4 = t + 3 * k2 * lt;
+
+    // Winogradova varianta: 7 soucinu polovicni velikosti a 15 scitani
+    addBlocks(m2, k2, A21, lda, 1, A22, lda, S1, ls);
+    addBlocks(m2, k2, S1, ls, -1, A11, lda, S2, ls);
+    addBlocks(m2, k2, A11, lda, -1, A21, lda, S3, ls);
+    addBlocks(m2, k2, A12, lda, -1, S2, ls, S4, ls);
+    addBlocks(k2, n2, B12, ldb, -1, B11, ldb, T1, lt);
+    addBlocks(k2, n2, B22, ldb, -1, T1, lt, T2, lt);
+    addBlocks(k2, n2, B22, ldb, -1, B12, ldb, T3, lt);
+    addBlocks(k2, n2, T2, lt, -1, B21, ldb, T4, lt);
+
+    gemmStrassen(pool, m2, n2, k2, A11, lda, B11, ldb, x, lt, STRASSEN_LEAF);    // P1
+    gemmStrassen(pool, m2, n2, k2, A12, lda, B21, ldb, C11, ldc, STRASSEN_LEAF); // P2
+    addBlocks(m2, n2, C11, ldc, 1, x, lt, C11, ldc);                             // C11 = P1 + P2
+    gemmStrassen(pool, m2, n2, k2, S2, ls, T2, lt, C12, ldc, STRASSEN_LEAF);     // P6
+    addBlocks(m2, n2, C12, ldc, 1, x, lt, C12, ldc);                             // U2 = P1 + P6
+    gemmStrassen(pool, m2, n2, k2, S3, ls, T3, lt, C21, ldc, STRASSEN_LEAF);     // P7
+    addBlocks(m2, n2, C21, ldc, 1, C12, ldc, C21, ldc);                          // U3 = U2 + P7
+    gemmStrassen(pool, m2, n2, k2, S1, ls, T1, lt, x, lt, STRASSEN_LEAF);        // P5
+    addBlocks(m2, n2, C12, ldc, 1, x, lt, C12, ldc);                             // U4 = U2 + P5
+    addBlocks(m2, n2, C21, ldc, 1, x, lt, C22, ldc);                             // C22 = U3 + P5
+    gemmStrassen(pool, m2, n2, k2, S4, ls, B22, ldb, x, lt, STRASSEN_LEAF);      // P3
+    addBlocks(m2, n2, C12, ldc, 1, x, lt, C12, ldc);                             // C12 = U4 + P3
+    gemmStrassen(pool, m2, n2, k2, A22, lda, T4, lt, x, lt, STRASSEN_LEAF);      // P4
+    addBlocks(m2, n2, C21, ldc, -1, x, lt, C21, ldc);                            // C21 = U3 - P4
+
+    alignedFree(s);
+    alignedFree(t);
+    alignedFree(x);
+
+    if(2 * k2 < k)
+        gemmParallel(pool, 2 * m2, 2 * n2, 1, 1.0, A + 2 * k2, lda, B + 2 * k2 * ldb, ldb, 1.0, C, ldc);
+    if(2 * n2 < n)
+        gemmParallel(pool, m, 1, k, 1.0, A, lda, B + 2 * n2, ldb, 0.0, C + 2 * n2, ldc);
+    if(2 * m2 < m)
+        gemmParallel(pool, 1, 2 * n2, k, 1.0, A + 2 * m2 * lda, lda, B, ldb, 0.0, C + 2 * m2 * ldc, ldc);
+}
+// Jadra s parametrem T pro matice v dvojite i jednoduche presnosti
+#define INSTANTIATE_KERNELS(T) \
+    template void gemm<T>(size_t, size_t, size_t, double, const T *, size_t, \
+                          const T *, size_t, double, T *, size_t); \
+    template void gemm<T>(Op, Op, size_t, size_t, size_t, double, const T *, size_t, \
+                          const T *, size_t, double, T *, size_t); \
+    template void gemmParallel<T>(ThreadPool *, size_t, size_t, size_t, double, const T *, size_t, \
+                                  const T *, size_t, double, T *, size_t); \
+    template void gemmParallel<T>(ThreadPool *, Op, Op, size_t, size_t, size_t, double, \
+                                  const T *, size_t, const T *, size_t, double, T *, size_t); \
+    template bool getrf<T>(size_t, T *, size_t, size_t *, double); \
+    template void getrs<T>(size_t, const T *, size_t, const size_t *, T *); \
+    template void trsmLowerUnit<T>(size_t, size_t, const T *, size_t, T *, size_t); \
+    template void trsmUpper<T>(size_t, size_t, const T *, size_t, T *, size_t);
+
+INSTANTIATE_KERNELS(double)
+INSTANTIATE_KERNELS(float)
+
+#undef INSTANTIATE_KERNELS
+
+}
+
+/*** Konec souboru matrix_kernels.cpp ***/
@@ -0,0 +1,632 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - low level matrix kernels
+//
+// $NoKeywords: $ivs_project_1 $matrix_kernels.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file matrix_kernels.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Deklarace nizkourovnovych vypocetnich jader nad souvislymi poli
+ *        prvku ulozenymi po radcich (row-major) s danou vzdalenosti radku.
+ */
+
+#pragma once
+
+#ifndef MATRIX_KERNELS_H_
+#define MATRIX_KERNELS_H_
+
+#include <cstddef>
+
+class ThreadPool;
+
+/**
+ * Zarovnani uloziste matice v bajtech (velikost radku cache)
+ */
+#define MATRIX_ALIGN_BYTES 64
+
+/**
+ * Pocet prvku typu double v jednom zarovnanem bloku
+ */
+#define MATRIX_ALIGN_ELEMS (MATRIX_ALIGN_BYTES / sizeof(double))
+
+namespace MatrixKernels
+{
+  /**
+   * Rozmery bloku nasobeni matic. Blok A (GEMM_MC x GEMM_KC) se vejde do L2,
+   * pruh B (GEMM_KC x GEMM_NR) do L1 a dlazdice C (GEMM_MR x GEMM_NR) do
+   * registru.
+   */
+  const size_t GEMM_MR = 4;
+  const size_t GEMM_NR = 8;
+  const size_t GEMM_MC = 128;
+  const size_t GEMM_KC = 256;
+  const size_t GEMM_NC = 2048;
+
+  /**
+   * Soucin s mene nez GEMM_PARALLEL_MIN nasobenimi (m * n * k) se vzdy
+   * pocita v jednom vlakne, rezie uloh by prevazila zisk.
+   */
+  const size_t GEMM_PARALLEL_MIN = 64 * 64 * 64;
+
+  /**
+   * Soucin matice s vektorem s mene nez GEMV_PARALLEL_MIN prvky matice
+   * se pocita v jednom vlakne. GEMV je omezeny propustnosti pameti, dalsi
+   * vlakna pomohou az u matic, ktere se nevejdou do cache jednoho jadra.
+   */
+  const size_t GEMV_PARALLEL_MIN = 256 * 256;
+
+  /**
+   * Minimalni pocet radku (u transponovaneho soucinu sloupcu) jedne ulohy
+   * paralelniho gemv
+   */
+  const size_t GEMV_MIN_BLOCK = 64;
+
+  /**
+   * Skalarni soucin vektoru kratsich nez DOT_PARALLEL_MIN se pocita
+   * v jednom vlakne, delsi se deli na useky alespon DOT_MIN_BLOCK prvku
+   */
+  const size_t DOT_PARALLEL_MIN = 64 * 1024;
+  const size_t DOT_MIN_BLOCK = 16 * 1024;
+
+  /**
+   * Sirka panelu blokoveho LU rozkladu a bloku trojuhelnikovych soustav
+   */
+  const size_t LU_NB = 64;
+
+  /**
+   * Pocet Householderovych reflektoru v jednom bloku QR rozkladu
+   */
+  const size_t QR_NB = 32;
+
+  /**
+   * Minimalni pocet radku na vlakno, od ktereho gels deli vysokou matici
+   * mezi vlakna (TSQR), nasobeno poctem sloupcu
+   */
+  const size_t TSQR_MIN_ROWS = 16;
+
+  /**
+   * Nejmensi rozmer, od ktereho gemmStrassen rekurzi vubec spusti (mensi
+   * soucin spocita primo gemmParallel). Zmereno na jednom jadru (-O2):
+   * Strassen byl rychlejsi od n = 2048, u n = 1024 zisk nebyl.
+   */
+  const size_t STRASSEN_THRESHOLD = 2048;
+
+  /**
+   * Rozmer listu rekurze: jednou spustena rekurze pokracuje, dokud jsou
+   * vsechny rozmery alespon STRASSEN_LEAF. Hodnoty 256 a 512 se lisily
+   * mene nez rozptyl mereni, vyssi ma mensi chybu (mene urovni rekurze).
+   */
+  const size_t STRASSEN_LEAF = 512;
+
+  /**
+   * Nejvyssi pocet kroku iteracniho zpresneni v gesvMixed, pak se reseni
+   * vzda (stejna mez jako dsgesv v LAPACK)
+   */
+  const size_t MIXED_MAX_ITERATIONS = 30;
+
+  /**
+   * Velikost bloku, pod kterou se transpozice uz dale nedeli
+   */
+  const size_t TRANSPOSE_BLOCK = 16;
+
+  /**
+   * @brief      alignedAlloc
+   *        * alokuje pole count prvku zarovnane na MATRIX_ALIGN_BYTES
+   *
+   * @param      count  pocet prvku
+   *
+   * @return     ukazatel na neinicializovane pole, pri chybe vyhodi
+   *             std::bad_alloc
+   */
+  double *alignedAlloc(size_t count);
+
+  /**
+   * @brief      alignedAllocBytes
+   *        * jako alignedAlloc, velikost je dana v bajtech (pro pole
+   *          jineho typu nez double)
+   */
+  void *alignedAllocBytes(size_t bytes);
+
+  /**
+   * @brief      alignedFree
+   *        * uvolni pole alokovane pomoci alignedAlloc nebo alignedAllocBytes
+   *
+   * @param      ptr  uvolnovane pole (muze byt nullptr)
+   */
+  void alignedFree(void *ptr);
+
+  /**
+   * @brief      alignedAllocCount
+   *        * vrati celkovy pocet volani alignedAlloc od startu programu
+   *          (pro overeni, ze operace nealokuji zbytecne kopie)
+   *
+   * @return     pocet alokaci
+   */
+  size_t alignedAllocCount();
+
+  /**
+   * @brief      gemm
+   *        * vypocte C = alpha * A * B + beta * C, kde A je m x k, B je k x n
+   *          a C je m x n. Pri beta == 0 se puvodni obsah C necte.
+   *          Prvky jsou typu T = double nebo float (jadra s parametrem T
+   *          jsou instancovana pro oba typy v matrix_kernels.cpp).
+   *
+   * @param      m, n, k    rozmery soucinu
+   * @param      alpha      nasobek soucinu A * B
+   * @param      A, lda     prvni cinitel a vzdalenost jeho radku
+   * @param      B, ldb     druhy cinitel a vzdalenost jeho radku
+   * @param      beta       nasobek puvodniho obsahu C
+   * @param      C, ldc     vysledek a vzdalenost jeho radku
+   */
+  template<class T>
+  void gemm(size_t m, size_t n, size_t k, double alpha,
+            const T *A, size_t lda, const T *B, size_t ldb,
+            double beta, T *C, size_t ldc);
+
+  /**
+   * @brief      gemmParallel
+   *        * stejne jako gemm, ale vysledek C rozdeli na 2D dlazdice, ktere
+   *          se pocitaji jako samostatne ulohy ve fondu vlaken. Male soucty
+   *          (pod GEMM_PARALLEL_MIN) se spocitaji primo v jednom vlakne.
+   *
+   * @param      pool   fond vlaken (nullptr znamena ThreadPool::shared())
+   */
+  template<class T>
+  void gemmParallel(ThreadPool *pool, size_t m, size_t n, size_t k, double alpha,
+                    const T *A, size_t lda, const T *B, size_t ldb,
+                    double beta, T *C, size_t ldc);
+
+  /**
+   * Zpusob cteni operandu soucinu: primo, nebo transponovane. Transponovany
+   * operand A je ulozen jako k x m, transponovany operand B jako n x k,
+   * transpozice se provede az pri zabaleni panelu, bez kopie celeho operandu.
+   */
+  enum Op
+  {
+    NO_TRANS,
+    TRANS
+  };
+
+  /**
+   * @brief      gemm
+   *        * vypocte C = alpha * op(A) * op(B) + beta * C
+   *
+   * @param      opA, opB   zpusob cteni operandu A a B
+   */
+  template<class T>
+  void gemm(Op opA, Op opB, size_t m, size_t n, size_t k, double alpha,
+            const T *A, size_t lda, const T *B, size_t ldb,
+            double beta, T *C, size_t ldc);
+
+  /**
+   * @brief      gemmParallel
+   *        * vypocte C = alpha * op(A) * op(B) + beta * C paralelne
+   */
+  template<class T>
+  void gemmParallel(ThreadPool *pool, Op opA, Op opB, size_t m, size_t n, size_t k, double alpha,
+                    const T *A, size_t lda, const T *B, size_t ldb,
+                    double beta, T *C, size_t ldc);
+
+  /**
+   * @brief      gemv
+   *        * vypocte y = alpha * op(A) * x + beta * y pro matici A m x n.
+   *          Matice se cte jednim pruchodem po radcich bez baleni (gemm
+   *          s jednim sloupcem by A kopiroval a z mikro-jadra vyuzil jen
+   *          jeden sloupec). Pro NO_TRANS je y[i] skalarni soucin radku
+   *          s x (jadro dot), pro TRANS se radky A pricitaji k y (jadro
+   *          fma). Velke matice se deli mezi vlakna po radcich,
+   *          transponovany soucin po sloupcich, u uzkych matic po radcich
+   *          s dilcimi soucty.
+   *
+   * @param      pool   fond vlaken (nullptr = ThreadPool::shared())
+   * @param      x      vstup delky n (NO_TRANS) nebo m (TRANS)
+   * @param      beta   pri beta = 0 se puvodni obsah y necte
+   * @param      y      vystup delky m (NO_TRANS) nebo n (TRANS), nesmi se
+   *                    prekryvat s A ani x
+   */
+  void gemv(ThreadPool *pool, Op op, size_t m, size_t n, double alpha, const double *A, size_t lda,
+            const double *x, double beta, double *y);
+
+  /**
+   * @brief      dot
+   *        * skalarni soucin x . y jadrem elementwise().dot, dlouhe vektory
+   *          po usecich ve fondu vlaken (dilci soucty se sectou v poradi
+   *          useku)
+   *
+   * @param      pool   fond vlaken (nullptr = ThreadPool::shared())
+   * @param      n      delka vektoru
+   */
+  double dot(ThreadPool *pool, size_t n, const double *x, const double *y);
+
+  /**
+   * @brief      gemmStrassen
+   *        * C = A * B Strassen-Winogradovou rekurzi (7 soucinu polovicni
+   *          velikosti misto 8). Rekurze zacne, jen pokud jsou vsechny
+   *          rozmery alespon threshold, a pokracuje, dokud jsou alespon
+   *          STRASSEN_LEAF, listy pocita gemmParallel. Pracovni pamet je
+   *          priblizne 4/3 (m k + k n + m n / 4) prvku navic.
+   *
+   *          Chyba neni omezena po prvcich jako u klasickeho soucinu
+   *          (|C - C'| <= k u |A| |B|), ale pouze v norme:
+   *          max|C - C'| <= c u max|A| max|B|, kde u = 2^-53 a pro
+   *          n = 2^d n0 (n0 = rozmer pri prechodu na gemm) je
+   *          c ~ (n0^2 + 6 n0) (n / n0)^log2(18) (Higham, Accuracy and
+   *          Stability of Numerical Algorithms, kap. 23). Kazda uroven
+   *          rekurze tak zhorsi mez priblizne 18 / 4 = 4.5krat oproti
+   *          klasickemu nasobeni. Vhodne pro matice s prvky podobne
+   *          velikosti, nevhodne pro spatne skalovane vstupy.
+   *
+   * @param      pool       fond vlaken pro soucin v listech rekurze
+   * @param      m, n, k    rozmery
+   * @param      A, lda     matice m x k
+   * @param      B, ldb     matice k x n
+   * @param      C, ldc     vysledek m x n (prepsan), nesmi se prekryvat s A, B
+   * @param      threshold  nejmensi rozmer, od ktereho se rekurze spusti
+   */
+  void gemmStrassen(ThreadPool *pool, size_t m, size_t n, size_t k, const double *A, size_t lda,
+                    const double *B, size_t ldb, double *C, size_t ldc,
+                    size_t threshold = STRASSEN_THRESHOLD);
+
+  /**
+   * @brief      transpose
+   *        * B = A^T, rekurzivni (cache-oblivious) deleni na bloky,
+   *          ktere se vejdou do L1 bez ohledu na jeji velikost
+   *
+   * @param      m, n       rozmery A
+   * @param      A, lda     transponovana matice
+   * @param      B, ldb     vysledek (n x m), nesmi se prekryvat s A
+   */
+  void transpose(size_t m, size_t n, const double *A, size_t lda, double *B, size_t ldb);
+
+  /**
+   * @brief      transposeInPlace
+   *        * transponuje ctvercovou matici na miste, rekurzivne
+   *          transponuje diagonalni bloky a prohodi mimodiagonalni
+   *
+   * @param      n          rad matice
+   * @param      A, lda     transponovana matice
+   */
+  void transposeInPlace(size_t n, double *A, size_t lda);
+
+  /**
+   * @brief      getrf
+   *        * LU rozklad ctvercove matice s castecnou pivotaci (PA = LU),
+   *          provedeny na miste. Pod diagonalou zustane L (s jednotkovou
+   *          diagonalou, ktera se neuklada), na a nad diagonalou U.
+   *          Rozklad je blokovy po panelech sirky LU_NB, aktualizace zbytku
+   *          matice bezi pres gemmParallel. Pro T = float (viz gemm)
+   *          zpracuje pri stejne propustnosti pameti dvojnasobek prvku.
+   *
+   * @param      n          rad matice
+   * @param      A, lda     rozkladana matice a vzdalenost jejich radku
+   * @param      pivots     pole n indexu, radek k byl prohozen s radkem
+   *                        pivots[k]
+   * @param      tolerance  pivot s absolutni hodnotou <= tolerance se
+   *                        povazuje za nulovy
+   *
+   * @return     true, pokud je matice regularni, jinak false (rozklad je
+   *             pak zastaven u prvniho nuloveho pivotu)
+   */
+  template<class T>
+  bool getrf(size_t n, T *A, size_t lda, size_t *pivots, double tolerance);
+
+  /**
+   * @brief      getrs
+   *        * vyresi soustavu A x = b pomoci rozkladu z getrf (prohozeni
+   *          radku, dopredna a zpetna substituce)
+   *
+   * @param      n          rad matice
+   * @param      LU, lda    rozklad z getrf a vzdalenost jeho radku
+   * @param      pivots     pivoty z getrf
+   * @param      b          prava strana, prepsana resenim x
+   */
+  template<class T>
+  void getrs(size_t n, const T *LU, size_t lda, const size_t *pivots, T *b);
+
+  /**
+   * @brief      gesvMixed
+   *        * vyresi A x = b ve smisene presnosti: rozklad getrf probehne
+   *          v typu float, reziduum r = b - A x se pocita v double a oprava
+   *          A d = r se resi opet rozkladem ve float, dokud
+   *          ||r|| <= ||x|| ||A|| eps sqrt(n) (normy max, eps typu double).
+   *          Pro cond(A) vyrazne pod 1 / eps(float) ~ 10^7 dosahne presnosti
+   *          double po nekolika krocich O(n^2).
+   *
+   * @param      n          rad matice
+   * @param      A, lda     matice soustavy (nemeni se)
+   * @param      b          prava strana, pri uspechu prepsana resenim x
+   *
+   * @return     pocet reseni s rozkladem ve float (alespon 1), nebo 0,
+   *             pokud matice nelze rozlozit ve float nebo zpresneni
+   *             nedokonvergovalo do MIXED_MAX_ITERATIONS (b se pak nemeni
+   *             a volajici ma resit soustavu v double)
+   */
+  size_t gesvMixed(size_t n, const double *A, size_t lda, double *b);
+
+  /**
+   * @brief      getrsTransposed
+   *        * vyresi soustavu A^T x = b pomoci rozkladu A z getrf, bez
+   *          transpozice rozkladu (radky U a L se ctou souvisle)
+   *
+   * @param      n          rad matice
+   * @param      LU, lda    rozklad z getrf a vzdalenost jeho radku
+   * @param      pivots     pivoty z getrf
+   * @param      b          prava strana, prepsana resenim x
+   */
+  void getrsTransposed(size_t n, const double *LU, size_t lda, const size_t *pivots, double *b);
+
+  /**
+   * @brief      getrsBatch
+   *        * vyresi soustavy A X = B pro vice pravych stran najednou
+   *          (sloupce B) pomoci rozkladu z getrf. Trojuhelnikove soustavy
+   *          jsou blokove (vetsina prace probiha v gemm), velke ulohy se
+   *          deli na svisle pruhy B mezi vlakna.
+   *
+   * @param      pool       fond vlaken (nullptr znamena ThreadPool::shared())
+   * @param      n          rad matice
+   * @param      nrhs       pocet pravych stran (sloupcu B)
+   * @param      LU, lda    rozklad z getrf a vzdalenost jeho radku
+   * @param      pivots     pivoty z getrf
+   * @param      B, ldb     prave strany, prepsane resenim X
+   */
+  void getrsBatch(ThreadPool *pool, size_t n, size_t nrhs, const double *LU, size_t lda,
+                  const size_t *pivots, double *B, size_t ldb);
+
+  /**
+   * @brief      trsmLowerUnit
+   *        * vyresi L X = B na miste, L je dolni trojuhelnikova s jednotkovou
+   *          diagonalou (horni trojuhelnik L se necte)
+   *
+   * @param      n, nrhs    rad L a pocet sloupcu B
+   * @param      L, lda     trojuhelnikova matice
+   * @param      B, ldb     prave strany, prepsane resenim
+   */
+  template<class T>
+  void trsmLowerUnit(size_t n, size_t nrhs, const T *L, size_t lda, T *B, size_t ldb);
+
+  /**
+   * @brief      trsmUpper
+   *        * vyresi U X = B na miste, U je horni trojuhelnikova (dolni
+   *          trojuhelnik U se necte)
+   *
+   * @param      n, nrhs    rad U a pocet sloupcu B
+   * @param      U, lda     trojuhelnikova matice
+   * @param      B, ldb     prave strany, prepsane resenim
+   */
+  template<class T>
+  void trsmUpper(size_t n, size_t nrhs, const T *U, size_t lda, T *B, size_t ldb);
+
+  /**
+   * @brief      potrf
+   *        * Choleskeho rozklad symetricke pozitivne definitni matice
+   *          A = L L^T na miste. Cte se pouze dolni trojuhelnik A, po
+   *          rozkladu v nem lezi L, horni trojuhelnik je nedefinovany.
+   *          Rozklad je blokovy po LU_NB, aktualizace zbytku pocita jen
+   *          dolni trojuhelnik (polovina prace LU) a bezi paralelne.
+   *
+   * @param      n          rad matice
+   * @param      A, lda     rozkladana matice a vzdalenost jejich radku
+   *
+   * @return     true, pokud je matice pozitivne definitni, jinak false
+   */
+  bool potrf(size_t n, double *A, size_t lda);
+
+  /**
+   * @brief      potrs
+   *        * vyresi soustavu A x = b pomoci rozkladu z potrf
+   *
+   * @param      n          rad matice
+   * @param      L, lda     rozklad z potrf a vzdalenost jeho radku
+   * @param      b          prava strana, prepsana resenim x
+   */
+  void potrs(size_t n, const double *L, size_t lda, double *b);
+
+  /**
+   * @brief      potrsBatch
+   *        * vyresi A X = B pro vice pravych stran (sloupce B) pomoci
+   *          rozkladu z potrf, stejne deleni prace jako getrsBatch
+   *
+   * @param      pool       fond vlaken (nullptr znamena ThreadPool::shared())
+   * @param      n          rad matice
+   * @param      nrhs       pocet pravych stran (sloupcu B)
+   * @param      L, lda     rozklad z potrf a vzdalenost jeho radku
+   * @param      B, ldb     prave strany, prepsane resenim X
+   */
+  void potrsBatch(ThreadPool *pool, size_t n, size_t nrhs, const double *L, size_t lda,
+                  double *B, size_t ldb);
+
+  /**
+   * @brief      trsmLower
+   *        * vyresi L X = B na miste, L je dolni trojuhelnikova (horni
+   *          trojuhelnik L se necte)
+   *
+   * @param      n, nrhs    rad L a pocet sloupcu B
+   * @param      L, lda     trojuhelnikova matice
+   * @param      B, ldb     prave strany, prepsane resenim
+   */
+  void trsmLower(size_t n, size_t nrhs, const double *L, size_t lda, double *B, size_t ldb);
+
+  /**
+   * @brief      trsmLowerTransposed
+   *        * vyresi L^T X = B na miste bez transpozice L
+   *
+   * @param      n, nrhs    rad L a pocet sloupcu B
+   * @param      L, lda     dolni trojuhelnikova matice
+   * @param      B, ldb     prave strany, prepsane resenim
+   */
+  void trsmLowerTransposed(size_t n, size_t nrhs, const double *L, size_t lda, double *B, size_t ldb);
+
+  /**
+   * @brief      trsmRightLowerTransposed
+   *        * vyresi X L^T = B na miste (dlazdice pod diagonalou
+   *          dlazdicoveho Choleskeho rozkladu), v jednom vlakne
+   *
+   * @param      m, n       pocet radku B a rad L
+   * @param      L, lda     dolni trojuhelnikova matice
+   * @param      B, ldb     prave strany m x n, prepsane resenim
+   */
+  void trsmRightLowerTransposed(size_t m, size_t n, const double *L, size_t lda, double *B, size_t ldb);
+
+  /**
+   * @brief      potrfTile
+   *        * stejne jako potrf, ale vzdy v jednom vlakne (diagonalni
+   *          dlazdice rozkladu v TiledFactorization, kde paralelismus
+   *          zajistuje graf uloh)
+   */
+  bool potrfTile(size_t n, double *A, size_t lda);
+
+  /**
+   * @brief      getrfTile
+   *        * blokovy LU rozklad s castecnou pivotaci vysokeho panelu m x n
+   *          (m >= n) v jednom vlakne. Radky se prohazuji jen uvnitr
+   *          panelu, zbytek matice dorovna laswp.
+   *
+   * @param      m, n       rozmery panelu
+   * @param      A, lda     rozkladany panel a vzdalenost jeho radku
+   * @param      pivots     pole n indexu relativne k panelu, radek k byl
+   *                        prohozen s radkem pivots[k]
+   * @param      tolerance  viz getrf
+   *
+   * @return     true, pokud nenarazil na nulovy pivot
+   */
+  bool getrfTile(size_t m, size_t n, double *A, size_t lda, size_t *pivots, double tolerance);
+
+  /**
+   * @brief      laswp
+   *        * postupne prohodi radky k a pivots[k] pro k z [k1, k2)
+   *
+   * @param      n          pocet sloupcu, ve kterych se radky prohazuji
+   * @param      A, lda     matice a vzdalenost jejich radku
+   */
+  void laswp(size_t n, double *A, size_t lda, size_t k1, size_t k2, const size_t *pivots);
+
+  /**
+   * @brief      geqrf
+   *        * blokovy Householderuv QR rozklad A = Q R matice m x n (m >= n)
+   *          na miste. Na a nad diagonalou zustane R, pod diagonalou
+   *          Householderovy vektory (s jednotkovym prvkem na diagonale,
+   *          ktery se neuklada). Bloky QR_NB reflektoru se na zbytek
+   *          matice aplikuji najednou (kompaktni WY tvar I - V T V^T)
+   *          pres gemm. Trojuhelnikove faktory T se ulozi pro ormqr
+   *          (jako u geqrt z LAPACK), ten je pak uz nepocita znovu.
+   *
+   * @param      m, n       rozmery A
+   * @param      A, lda     rozkladana matice a vzdalenost jejich radku
+   * @param      tau        pole n koeficientu reflektoru H = I - tau v v^T
+   * @param      T          pole QR_NB x n (vzdalenost radku n), faktor T
+   *                        bloku zacinajiciho sloupcem k je horni
+   *                        trojuhelnik v T + k
+   */
+  void geqrf(size_t m, size_t n, double *A, size_t lda, double *tau, double *T);
+
+  /**
+   * @brief      ormqr
+   *        * B = Q^T B pro Q z rozkladu geqrf, reflektory se pouzivaji
+   *          primo z QR bez kopirovani
+   *
+   * @param      m, n       rozmery rozlozene matice
+   * @param      nrhs       pocet sloupcu B
+   * @param      QR, lda    rozklad z geqrf a vzdalenost jeho radku
+   * @param      T          faktory T z geqrf
+   * @param      B, ldb     matice m x nrhs, prepsana vysledkem
+   */
+  void ormqr(size_t m, size_t n, size_t nrhs, const double *QR, size_t lda, const double *T,
+             double *B, size_t ldb);
+
+  /**
+   * @brief      gels
+   *        * reseni linearni ulohy nejmensich ctvercu min ||A x - b|| pro
+   *          m >= n bez sestaveni normalnich rovnic. Vysoka matice se
+   *          rozdeli po radcich mezi vlakna, kazda cast se rozlozi
+   *          samostatne a jejich faktory R se rozlozi znovu (TSQR).
+   *
+   * @param      pool       fond vlaken (nullptr znamena ThreadPool::shared())
+   * @param      m, n       rozmery A
+   * @param      A, lda     matice soustavy, po vypoctu prepsana
+   * @param      b          prava strana delky m, reseni v prvnich n prvcich
+   * @param      tolerance  prvek diagonaly R s absolutni hodnotou
+   *                        <= tolerance se povazuje za nulovy
+   *
+   * @return     true, pokud ma matice plnou hodnost, jinak false
+   */
+  bool gels(ThreadPool *pool, size_t m, size_t n, double *A, size_t lda, double *b, double tolerance);
+
+  /**
+   * Instrukcni sady, pro ktere existuje varianta prvkovych jader
+   */
+  enum Isa
+  {
+    ISA_SCALAR,
+    ISA_SSE2,
+    ISA_AVX2,
+    ISA_AVX512,
+    ISA_COUNT
+  };
+
+  /**
+   * @brief Sada prvkovych (element-wise) jader pro jednu instrukcni sadu.
+   * Vsechna jadra pracuji nad souvislymi poli delky n, vystup smi byt
+   * totozny s nekterym ze vstupu. T je double nebo float (float varianty
+   * zpracuji v jednom registru dvojnasobny pocet prvku).
+   */
+  template<class T>
+  struct BasicElementwiseKernels
+  {
+    Isa isa;            ///< Instrukcni sada teto varianty.
+    const char *name;   ///< Nazev varianty (pro ladeni a testy).
+
+    /// out[i] = x[i] + y[i]
+    void (*add)(size_t n, const T *x, const T *y, T *out);
+    /// out[i] = alpha * x[i]
+    void (*scale)(size_t n, T alpha, const T *x, T *out);
+    /// out[i] = alpha * x[i] + y[i]
+    void (*fma)(size_t n, T alpha, const T *x, const T *y, T *out);
+    /// soucet x[i] * y[i] (poradi scitani zavisi na variante)
+    T (*dot)(size_t n, const T *x, const T *y);
+    /// true, pokud x[i] == y[i] pro vsechna i
+    bool (*equal)(size_t n, const T *x, const T *y);
+  };
+
+  typedef BasicElementwiseKernels<double> ElementwiseKernels;
+  typedef BasicElementwiseKernels<float> ElementwiseKernelsF;
+
+  /**
+   * @brief      isaSupported
+   *        * zjisti (pomoci CPUID), zda procesor i prekladac podporuji
+   *          danou instrukcni sadu
+   *
+   * @param      isa   instrukcni sada
+   *
+   * @return     true, pokud lze varianty jader pro isa spoustet
+   */
+  bool isaSupported(Isa isa);
+
+  /**
+   * @brief      elementwiseFor
+   *        * vrati variantu prvkovych jader pro danou instrukcni sadu
+   *
+   * @param      isa   instrukcni sada
+   *
+   * @return     ukazatel na jadra, nebo nullptr, pokud je isa nepodporovana
+   */
+  template<class T = double>
+  const BasicElementwiseKernels<T> *elementwiseFor(Isa isa);
+
+  /**
+   * @brief      elementwise
+   *        * vrati nejsirsi podporovanou variantu prvkovych jader, vyber
+   *          probehne jednou pri prvnim volani
+   *
+   * @return     prvkova jadra pro tento procesor
+   */
+  template<class T = double>
+  const BasicElementwiseKernels<T> &elementwise();
+}
+
+#endif /* MATRIX_KERNELS_H_ */
+
+/*** Konec souboru matrix_kernels.h ***/
@@ -0,0 +1,660 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - vectorized element-wise matrix kernels
+//
+// $NoKeywords: $ivs_project_1 $matrix_simd.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file matrix_simd.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Definice prvkovych jader (skalarni, SSE2, AVX2, AVX-512) pro double
+ *        i float a jejich vyber podle schopnosti procesoru za behu.
+ */
+
+#include "matrix_kernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MATRIX_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace MatrixKernels
+{
+
+//---------------------------------------------------------------------------
+// Skalarni referencni varianta
+//---------------------------------------------------------------------------
+
+template<class T>
+static void addScalar(size_t n, const T *x, const T *y, T *out)
+{
+    for(size_t i = 0; i < n; i++)
+        out[i] = x[i] + y[i];
+}
+
+template<class T>
+static void scaleScalar(size_t n, T alpha, const T *x, T *out)
+{
+    for(size_t i = 0; i < n; i++)
+        out[i] = alpha * x[i];
+}
+
+template<class T>
+static void fmaScalar(size_t n, T alpha, const T *x, const T *y, T *out)
+{
+    for(size_t i = 0; i < n; i++)
+        out[i] = alpha * x[i] + y[i];
+}
+
+template<class T>
+static T dotScalar(size_t n, const T *x, const T *y)
+{
+    T sum = 0;
+
+    for(size_t i = 0; i < n; i++)
+        sum += x[i] * y[i];
+
+    return sum;
+}
+
+template<class T>
+static bool equalScalar(size_t n, const T *x, const T *y)
+{
+    for(size_t i = 0; i < n; i++)
+    {
+        if(x[i] != y[i])
+            return false;
+    }
+
+    return true;
+}
+
+static const ElementwiseKernels scalarKernels = {
+    ISA_SCALAR, "scalar", addScalar<double>, scaleScalar<double>, fmaScalar<double>,
+    dotScalar<double>, equalScalar<double>
+};
+
+static const ElementwiseKernelsF scalarKernelsF = {
+    ISA_SCALAR, "scalar", addScalar<float>, scaleScalar<float>, fmaScalar<float>,
+    dotScalar<float>, equalScalar<float>
+};
+
+#ifdef MATRIX_SIMD_X86
+
+//---------------------------------------------------------------------------
+// SSE2 (2 prvky double nebo 4 float na registr)
+//---------------------------------------------------------------------------
+
+__attribute__((target("sse2")))
+static void addSse2(size_t n, const double *x, const double *y, double *out)
+{
+    size_t i = 0;
+
+    for(; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+
+    addScalar(n - i, x + i, y + i, out + i);
+}
+
+__attribute__((target("sse2")))
+static void scaleSse2(size_t n, double alpha, const double *x, double *out)
+{
+    const __m128d a = _mm_set1_pd(alpha);
+    size_t i = 0;
+
+    for(; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_mul_pd(a, _mm_loadu_pd(x + i)));
+
+    scaleScalar(n - i, alpha, x + i, out + i);
+}
+
+__attribute__((target("sse2")))
+static void fmaSse2(size_t n, double alpha, const double *x, const double *y, double *out)
+{
+    const __m128d a = _mm_set1_pd(alpha);
+    size_t i = 0;
+
+    for(; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_add_pd(_mm_mul_pd(a, _mm_loadu_pd(x + i)), _mm_loadu_pd(y + i)));
+
+    fmaScalar(n - i, alpha, x + i, y + i, out + i);
+}
+
+__attribute__((target("sse2")))
+static double dotSse2(size_t n, const double *x, const double *y)
+{
+    // Dva nezavisle soucty skryji latenci scitani
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+    {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2)));
+    }
+
+    double part[2];
+    _mm_storeu_pd(part, _mm_add_pd(s0, s1));
+
+    return part[0] + part[1] + dotScalar(n - i, x + i, y + i);
+}
+
+__attribute__((target("sse2")))
+static bool equalSse2(size_t n, const double *x, const double *y)
+{
+    size_t i = 0;
+
+    for(; i + 2 <= n; i += 2)
+    {
+        if(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i))) != 0x3)
+            return false;
+    }
+
+    return equalScalar(n - i, x + i, y + i);
+}
+
+__attribute__((target("sse2")))
+static void addSse2(size_t n, const float *x, const float *y, float *out)
+{
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+
+    addScalar(n - i, x + i, y + i, out + i);
+}
+
+__attribute__((target("sse2")))
+static void scaleSse2(size_t n, float alpha, const float *x, float *out)
+{
+    const __m128 a = _mm_set1_ps(alpha);
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+        _mm_storeu_ps(out + i, _mm_mul_ps(a, _mm_loadu_ps(x + i)));
+
+    scaleScalar(n - i, alpha, x + i, out + i);
+}
+
+__attribute__((target("sse2")))
+static void fmaSse2(size_t n, float alpha, const float *x, const float *y, float *out)
+{
+    const __m128 a = _mm_set1_ps(alpha);
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(a, _mm_loadu_ps(x + i)), _mm_loadu_ps(y + i)));
+
+    fmaScalar(n - i, alpha, x + i, y + i, out + i);
+}
+
+__attribute__((target("sse2")))
+static float dotSse2(size_t n, const float *x, const float *y)
+{
+    __m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+        s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(x + i + 4), _mm_loadu_ps(y + i + 4)));
+    }
+
+    float part[4];
+    _mm_storeu_ps(part, _mm_add_ps(s0, s1));
+
+    return (part[0] + part[1]) + (part[2] + part[3]) + dotScalar(n - i, x + i, y + i);
+}
+
+__attribute__((target("sse2")))
+static bool equalSse2(size_t n, const float *x, const float *y)
+{
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+    {
+        if(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i))) != 0xF)
+            return false;
+    }
+
+    return equalScalar(n - i, x + i, y + i);
+}
+
+static const ElementwiseKernels sse2Kernels = {
+    ISA_SSE2, "sse2", addSse2, scaleSse2, fmaSse2, dotSse2, equalSse2
+};
+
+static const ElementwiseKernelsF sse2KernelsF = {
+    ISA_SSE2, "sse2", addSse2, scaleSse2, fmaSse2, dotSse2, equalSse2
+};
+
+//---------------------------------------------------------------------------
+// AVX2 + FMA (4 prvky double nebo 8 float na registr)
+//---------------------------------------------------------------------------
+
+__attribute__((target("avx2,fma")))
+static void addAvx2(size_t n, const double *x, const double *y, double *out)
+{
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+
+    addScalar(n - i, x + i, y + i, out + i);
+}
+
+__attribute__((target("avx2,fma")))
+static void scaleAvx2(size_t n, double alpha, const double *x, double *out)
+{
+    const __m256d a = _mm256_set1_pd(alpha);
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(a, _mm256_loadu_pd(x + i)));
+
+    scaleScalar(n - i, alpha, x + i, out + i);
+}
+
+__attribute__((target("avx2,fma")))
+static void fmaAvx2(size_t n, double alpha, const double *x, const double *y, double *out)
+{
+    const __m256d a = _mm256_set1_pd(alpha);
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+
+    fmaScalar(n - i, alpha, x + i, y + i, out + i);
+}
+
+__attribute__((target("avx2,fma")))
+static double dotAvx2(size_t n, const double *x, const double *y)
+{
+    // Ctyri nezavisle soucty pokryji latenci FMA pri dvou FMA za takt
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+    {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), s1);
+        s2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8), _mm256_loadu_pd(y + i + 8), s2);
+        s3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_loadu_pd(y + i + 12), s3);
+    }
+
+    for(; i + 4 <= n; i += 4)
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), s0);
+
+    __m256d s = _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3));
+    __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1));
+    double part[2];
+    _mm_storeu_pd(part, h);
+
+    return part[0] + part[1] + dotScalar(n - i, x + i, y + i);
+}
+
+__attribute__((target("avx2,fma")))
+static bool equalAvx2(size_t n, const double *x, const double *y)
+{
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+    {
+        __m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), _CMP_EQ_OQ);
+
+        if(_mm256_movemask_pd(eq) != 0xF)
+            return false;
+    }
+
+    return equalScalar(n - i, x + i, y + i);
+}
+
+__attribute__((target("avx2,fma")))
+static void addAvx2(size_t n, const float *x, const float *y, float *out)
+{
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+
+    addScalar(n - i, x + i, y + i, out + i);
+}
+
+__attribute__((target("avx2,fma")))
+static void scaleAvx2(size_t n, float alpha, const float *x, float *out)
+{
+    const __m256 a = _mm256_set1_ps(alpha);
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(a, _mm256_loadu_ps(x + i)));
+
+    scaleScalar(n - i, alpha, x + i, out + i);
+}
+
+__attribute__((target("avx2,fma")))
+static void fmaAvx2(size_t n, float alpha, const float *x, const float *y, float *out)
+{
+    const __m256 a = _mm256_set1_ps(alpha);
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_fmadd_ps(a, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+
+    fmaScalar(n - i, alpha, x + i, y + i, out + i);
+}
+
+__attribute__((target("avx2,fma")))
+static float dotAvx2(size_t n, const float *x, const float *y)
+{
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+    __m256 s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    size_t i = 0;
+
+    for(; i + 32 <= n; i += 32)
+    {
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), s0);
+        s1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), s1);
+        s2 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 16), _mm256_loadu_ps(y + i + 16), s2);
+        s3 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 24), _mm256_loadu_ps(y + i + 24), s3);
+    }
+
+    for(; i + 8 <= n; i += 8)
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), s0);
+
+    __m256 s = _mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3));
+    __m128 h = _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1));
+    float part[4];
+    _mm_storeu_ps(part, h);
+
+    return (part[0] + part[1]) + (part[2] + part[3]) + dotScalar(n - i, x + i, y + i);
+}
+
+__attribute__((target("avx2,fma")))
+static bool equalAvx2(size_t n, const float *x, const float *y)
+{
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), _CMP_EQ_OQ);
+
+        if(_mm256_movemask_ps(eq) != 0xFF)
+            return false;
+    }
+
+    return equalScalar(n - i, x + i, y + i);
+}
+
+static const ElementwiseKernels avx2Kernels = {
+    ISA_AVX2, "avx2", addAvx2, scaleAvx2, fmaAvx2, dotAvx2, equalAvx2
+};
+
+static const ElementwiseKernelsF avx2KernelsF = {
+    ISA_AVX2, "avx2", addAvx2, scaleAvx2, fmaAvx2, dotAvx2, equalAvx2
+};
+
+//---------------------------------------------------------------------------
+// AVX-512F (8 prvku double nebo 16 float na registr)
+//---------------------------------------------------------------------------
+
+__attribute__((target("avx512f")))
+static void addAvx512(size_t n, const double *x, const double *y, double *out)
+{
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+
+    addScalar(n - i, x + i, y + i, out + i);
+}
+
+__attribute__((target("avx512f")))
+static void scaleAvx512(size_t n, double alpha, const double *x, double *out)
+{
+    const __m512d a = _mm512_set1_pd(alpha);
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(a, _mm512_loadu_pd(x + i)));
+
+    scaleScalar(n - i, alpha, x + i, out + i);
+}
+
+__attribute__((target("avx512f")))
+static void fmaAvx512(size_t n, double alpha, const double *x, const double *y, double *out)
+{
+    const __m512d a = _mm512_set1_pd(alpha);
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(out + i, _mm512_fmadd_pd(a, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+
+    fmaScalar(n - i, alpha, x + i, y + i, out + i);
+}
+
+__attribute__((target("avx512f")))
+static double dotAvx512(size_t n, const double *x, const double *y)
+{
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    size_t i = 0;
+
+    for(; i + 32 <= n; i += 32)
+    {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), s1);
+        s2 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 16), _mm512_loadu_pd(y + i + 16), s2);
+        s3 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 24), _mm512_loadu_pd(y + i + 24), s3);
+    }
+
+    for(; i + 8 <= n; i += 8)
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), s0);
+
+    __m512d s = _mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3));
+
+    return _mm512_reduce_add_pd(s) + dotScalar(n - i, x + i, y + i);
+}
+
+__attribute__((target("avx512f")))
+static bool equalAvx512(size_t n, const double *x, const double *y)
+{
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        __mmask8 eq = _mm512_cmp_pd_mask(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), _CMP_EQ_OQ);
+
+        if(eq != 0xFF)
+            return false;
+    }
+
+    return equalScalar(n - i, x + i, y + i);
+}
+
+__attribute__((target("avx512f")))
+static void addAvx512(size_t n, const float *x, const float *y, float *out)
+{
+    size_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+
+    addScalar(n - i, x + i, y + i, out + i);
+}
+
+__attribute__((target("avx512f")))
+static void scaleAvx512(size_t n, float alpha, const float *x, float *out)
+{
+    const __m512 a = _mm512_set1_ps(alpha);
+    size_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(out + i, _mm512_mul_ps(a, _mm512_loadu_ps(x + i)));
+
+    scaleScalar(n - i, alpha, x + i, out + i);
+}
+
+__attribute__((target("avx512f")))
+static void fmaAvx512(size_t n, float alpha, const float *x, const float *y, float *out)
+{
+    const __m512 a = _mm512_set1_ps(alpha);
+    size_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(out + i, _mm512_fmadd_ps(a, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+
+    fmaScalar(n - i, alpha, x + i, y + i, out + i);
+}
+
+__attribute__((target("avx512f")))
+static float dotAvx512(size_t n, const float *x, const float *y)
+{
+    __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+    __m512 s2 = _mm512_setzero_ps(), s3 = _mm512_setzero_ps();
+    size_t i = 0;
+
+    for(; i + 64 <= n; i += 64)
+    {
+        s0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), s0);
+        s1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16), s1);
+        s2 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 32), _mm512_loadu_ps(y + i + 32), s2);
+        s3 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 48), _mm512_loadu_ps(y + i + 48), s3);
+    }
+
+    for(; i + 16 <= n; i += 16)
+        s0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), s0);
+
+    __m512 s = _mm512_add_ps(_mm512_add_ps(s0, s1), _mm512_add_ps(s2, s3));
+
+    return _mm512_reduce_add_ps(s) + dotScalar(n - i, x + i, y + i);
+}
+
+__attribute__((target("avx512f")))
+static bool equalAvx512(size_t n, const float *x, const float *y)
+{
+    size_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+    {
+        __mmask16 eq = _mm512_cmp_ps_mask(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), _CMP_EQ_OQ);
+
+        if(eq != 0xFFFF)
+            return false;
+    }
+
+    return equalScalar(n - i, x + i, y + i);
+}
+
+static const ElementwiseKernels avx512Kernels = {
+    ISA_AVX512, "avx512", addAvx512, scaleAvx512, fmaAvx512, dotAvx512, equalAvx512
+};
+
+static const ElementwiseKernelsF avx512KernelsF = {
+    ISA_AVX512, "avx512", addAvx512, scaleAvx512, fmaAvx512, dotAvx512, equalAvx512
+};
+
+#endif /* MATRIX_SIMD_X86 */
+
+bool isaSupported(Isa isa)
+{
+    switch(isa)
+    {
+    case ISA_SCALAR:
+        return true;
+#ifdef MATRIX_SIMD_X86
+    case ISA_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case ISA_AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case ISA_AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * Tabulka variant pro prvky typu double
+ */
+static const ElementwiseKernels *kernelsFor(Isa isa, double)
+{
+    switch(isa)
+    {
+#ifdef MATRIX_SIMD_X86
+    case ISA_SSE2:
+        return &sse2Kernels;
+    case ISA_AVX2:
+        return &avx2Kernels;
+    case ISA_AVX512:
+        return &avx512Kernels;
+#endif
+    default:
+        return &scalarKernels;
+    }
+}
+
+/**
+ * Tabulka variant pro prvky typu float
+ */
+static const ElementwiseKernelsF *kernelsFor(Isa isa, float)
+{
+    switch(isa)
+    {
+#ifdef MATRIX_SIMD_X86
+    case ISA_SSE2:
+        return &sse2KernelsF;
+    case ISA_AVX2:
+        return &avx2KernelsF;
+    case ISA_AVX512:
+        return &avx512KernelsF;
+#endif
+    default:
+        return &scalarKernelsF;
+    }
+}
+
+template<class T>
+const BasicElementwiseKernels<T> *elementwiseFor(Isa isa)
+{
+    if(!isaSupported(isa))
+        return nullptr;
+
+    return kernelsFor(isa, T());
+}
+
+template<class T>
+static const BasicElementwiseKernels<T> *selectElementwise()
+{
+    for(int isa = ISA_COUNT - 1; isa > ISA_SCALAR; isa--)
+    {
+        const BasicElementwiseKernels<T> *kernels = elementwiseFor<T>(static_cast<Isa>(isa));
+
+        if(kernels != nullptr)
+            return kernels;
+    }
+
+    return kernelsFor(ISA_SCALAR, T());
+}
+
+template<class T>
+const BasicElementwiseKernels<T> &elementwise()
+{
+    static const BasicElementwiseKernels<T> *selected = selectElementwise<T>();
+
+    return *selected;
+}
+
+template const ElementwiseKernels *elementwiseFor<double>(Isa);
+template const ElementwiseKernelsF *elementwiseFor<float>(Isa);
+template const ElementwiseKernels &elementwise<double>();
+template const ElementwiseKernelsF &elementwise<float>();
+
+}
+
+/*** Konec souboru matrix_simd.cpp ***/
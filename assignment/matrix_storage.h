@@ -0,0 +1,259 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - aligned row-major matrix storage
+//
+// $NoKeywords: $ivs_project_1 $matrix_storage.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file matrix_storage.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Spolecne uloziste matic BasicMatrix<T>: zarovnane pole prvku
+ *        po radcich, jeho alokace, kopirovani, presun a pristup k prvkum.
+ *        Matrix (T = double) i obecna sablona (basic_matrix.h) z nej
+ *        dedi, operace nad maticemi uz definuji samy.
+ */
+
+#pragma once
+
+#ifndef MATRIX_STORAGE_H_
+#define MATRIX_STORAGE_H_
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "matrix_kernels.h"
+
+/**
+ * @brief Zarovnane uloziste matice s prvky typu T
+ * Kazdy radek zacina na adrese zarovnane na MATRIX_ALIGN_BYTES, vypln za
+ * poslednim sloupcem je vzdy nulova. Trida slouzi jen jako predek matic,
+ * samostatne ji vytvorit nelze.
+ */
+template<class T>
+class MatrixStorage
+{
+public:
+  /**
+   * @brief      set
+   *      * nastavi hodnotu v matici na pozici row, col
+   *
+   * @param      row    radek matice
+   * @param      col    sloupec matice
+   * @param      value  hodnota ulozena na pozici row, col
+   *
+   * @return     pokud bylo vlozeni uspesne vrati true, jinak false
+   */
+  bool set(size_t row, size_t col, T value)
+  {
+    if(!checkIndexes(row, col))
+      return false;
+
+    at(row, col) = value;
+
+    return true;
+  }
+
+  /**
+   * @brief      get
+   *      * vrati hodnotu v matici na pozici row, col, pro index mimo
+   *        matici vyhodi std::runtime_error
+   */
+  T get(size_t row, size_t col) const
+  {
+    if(!checkIndexes(row, col))
+      throw std::runtime_error("Pristup k indexu mimo matici");
+
+    return at(row, col);
+  }
+
+  /**
+   * @brief      pocet radku matice
+   */
+  size_t rows() const { return mRows; }
+
+  /**
+   * @brief      pocet sloupcu matice
+   */
+  size_t cols() const { return mCols; }
+
+  /**
+   * @brief      vzdalenost (v prvcich) mezi zacatky dvou sousednich radku
+   *        * tzv. leading dimension, radky zacinaji na adrese zarovnane
+   *          na MATRIX_ALIGN_BYTES
+   */
+  size_t stride() const { return mStride; }
+
+  /**
+   * @brief      ukazatel na zacatek souvisleho pole prvku (row-major)
+   *        * prvek [r][c] lezi na indexu r * stride() + c
+   */
+  T *data() { return mData; }
+  const T *data() const { return mData; }
+
+protected:
+  T *mData;
+
+  size_t mRows;
+
+  size_t mCols;
+
+  size_t mStride;
+
+  /**
+   * @brief MatrixStorage
+   * Prazdne uloziste (0x0), potomek jej naplni pomoci allocate
+   */
+  MatrixStorage(): mData(nullptr), mRows(0), mCols(0), mStride(0) {}
+
+  /**
+   * @brief MatrixStorage
+   * Hluboka kopie uloziste
+   */
+  MatrixStorage(const MatrixStorage &other): mData(nullptr), mRows(0), mCols(0), mStride(0)
+  {
+    if(other.mData == nullptr)
+      return;
+
+    allocate(other.mRows, other.mCols, false);
+    memcpy(mData, other.mData, mRows * mStride * sizeof(T));
+  }
+
+  /**
+   * @brief MatrixStorage
+   * Prevezme uloziste other bez kopirovani, other zustane prazdne (0x0)
+   */
+  MatrixStorage(MatrixStorage &&other):
+    mData(other.mData), mRows(other.mRows), mCols(other.mCols), mStride(other.mStride)
+  {
+    other.mData = nullptr;
+    other.mRows = other.mCols = other.mStride = 0;
+  }
+
+  ~MatrixStorage()
+  {
+    MatrixKernels::alignedFree(mData);
+  }
+
+  /**
+   * @brief      prirazeni
+   *        * pri shodne velikosti kopiruje do stavajiciho uloziste bez
+   *          alokace
+   */
+  MatrixStorage &operator=(const MatrixStorage &other)
+  {
+    if(this == &other)
+      return *this;
+
+    if(mRows != other.mRows || mCols != other.mCols || mData == nullptr)
+    {
+      MatrixKernels::alignedFree(mData);
+      mData = nullptr;
+      mRows = mCols = mStride = 0;
+
+      if(other.mData == nullptr)
+        return *this;
+
+      allocate(other.mRows, other.mCols, false);
+    }
+
+    memcpy(mData, other.mData, mRows * mStride * sizeof(T));
+
+    return *this;
+  }
+
+  /**
+   * @brief      presunuti
+   *        * prevezme uloziste other, puvodni uloziste uvolni
+   */
+  MatrixStorage &operator=(MatrixStorage &&other)
+  {
+    if(this == &other)
+      return *this;
+
+    MatrixKernels::alignedFree(mData);
+
+    mData = other.mData;
+    mRows = other.mRows;
+    mCols = other.mCols;
+    mStride = other.mStride;
+
+    other.mData = nullptr;
+    other.mRows = other.mCols = other.mStride = 0;
+
+    return *this;
+  }
+
+  /**
+   * @brief      alokuje (nulove) uloziste pro matici row x col
+   *
+   * @param      row        pocet radku
+   * @param      col        pocet sloupcu
+   * @param      zeroFill   pokud je false, nuluje se jen vypln za poslednim
+   *                        sloupcem a prvky zustanou neinicializovane,
+   *                        volajici je vsechny prepise
+   */
+  void allocate(size_t row, size_t col, bool zeroFill = true)
+  {
+    const size_t align = MATRIX_ALIGN_BYTES / sizeof(T);
+    const size_t maxElems = std::numeric_limits<size_t>::max() / sizeof(T);
+
+    if(col > maxElems - align)
+      throw std::length_error("Matice je prilis velka.");
+
+    size_t stride = (col + align - 1) / align * align;
+
+    if(row > maxElems / stride)
+      throw std::length_error("Matice je prilis velka.");
+
+    mData = static_cast<T *>(MatrixKernels::alignedAllocBytes(row * stride * sizeof(T)));
+
+    if(zeroFill)
+    {
+      memset(mData, 0, row * stride * sizeof(T));
+    }
+    else if(col < stride)
+    {
+      // Vypln musi zustat nulova i bez nulovani prvku
+      for(size_t r = 0; r < row; r++)
+        memset(mData + r * stride + col, 0, (stride - col) * sizeof(T));
+    }
+
+    mRows = row;
+    mCols = col;
+    mStride = stride;
+  }
+
+  /**
+   * @brief      pristup k prvku bez kontroly indexu
+   */
+  T &at(size_t row, size_t col) { return mData[row * mStride + col]; }
+  const T &at(size_t row, size_t col) const { return mData[row * mStride + col]; }
+
+  /**
+   * @brief      kontrola zda indexy row, col jsou v matici
+   *
+   * @return     Pokud je alespon jeden index mimo matici vrati false,
+   *             jinak true
+   */
+  bool checkIndexes(size_t row, size_t col) const
+  {
+    return row < mRows && col < mCols;
+  }
+
+  /**
+   * @brief      kontrola zda ma matice velikost rows x cols
+   */
+  bool checkEqualSize(size_t rows, size_t cols) const
+  {
+    return mRows == rows && mCols == cols;
+  }
+};
+
+#endif /* MATRIX_STORAGE_H_ */
+
+/*** Konec souboru matrix_storage.h ***/
@@ -0,0 +1,211 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - non-owning strided matrix views
+//
+// $NoKeywords: $ivs_project_1 $matrix_view.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file matrix_view.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Operace nad pohledy na matici. Vsechny jadra pracuji s obecnou
+ *        vzdalenosti radku, pohled se proto predava primo bez kopie.
+ */
+
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+#include "white_box_code.h"
+#include "factorization.h"
+
+bool operator==(ConstMatrixView a, ConstMatrixView b)
+{
+    if(a.rows() != b.rows() || a.cols() != b.cols())
+        throw std::runtime_error("Matice musi mit stejnou velikost.");
+
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+
+    for(size_t r = 0; r < a.rows(); r++)
+    {
+        if(!kernels.equal(a.cols(), a.data() + r * a.stride(), b.data() + r * b.stride()))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Zda se pameti dvou pohledu prekryvaji (od prvniho do posledniho prvku)
+ */
+static bool overlaps(ConstMatrixView a, ConstMatrixView b)
+{
+    std::less<const double *> less;
+    const double *aEnd = a.data() + (a.rows() - 1) * a.stride() + a.cols();
+    const double *bEnd = b.data() + (b.rows() - 1) * b.stride() + b.cols();
+
+    return less(a.data(), bEnd) && less(b.data(), aEnd);
+}
+
+Matrix operator+(ConstMatrixView a, ConstMatrixView b)
+{
+    if(a.rows() != b.rows() || a.cols() != b.cols())
+        throw std::runtime_error("Matice musi mit stejnou velikost.");
+
+    Matrix result(a.rows(), a.cols(), Matrix::NO_INIT);
+    add(a, b, result);
+
+    return result;
+}
+
+Matrix operator*(ConstMatrixView a, ConstMatrixView b)
+{
+    if(a.cols() != b.rows())
+        throw std::runtime_error("Prvni matice musi stejny pocet sloupcu jako druha radku.");
+
+    Matrix result(a.rows(), b.cols(), Matrix::NO_INIT);
+    multiply(a, b, result);
+
+    return result;
+}
+
+Matrix multiply(ConstMatrixView a, ConstMatrixView b, MultiplyPolicy policy)
+{
+    if(a.cols() != b.rows())
+        throw std::runtime_error("Prvni matice musi stejny pocet sloupcu jako druha radku.");
+
+    Matrix result(a.rows(), b.cols(), Matrix::NO_INIT);
+    multiply(a, b, result, policy);
+
+    return result;
+}
+
+Matrix operator*(ConstMatrixView a, double value)
+{
+    Matrix result(a.rows(), a.cols(), Matrix::NO_INIT);
+    multiply(a, value, result);
+
+    return result;
+}
+
+void add(ConstMatrixView a, ConstMatrixView b, MatrixView out)
+{
+    if(a.rows() != b.rows() || a.cols() != b.cols() ||
+       out.rows() != a.rows() || out.cols() != a.cols())
+        throw std::runtime_error("Matice musi mit stejnou velikost.");
+
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+
+    for(size_t r = 0; r < a.rows(); r++)
+    {
+        kernels.add(a.cols(), a.data() + r * a.stride(), b.data() + r * b.stride(),
+                    out.data() + r * out.stride());
+    }
+}
+
+void multiply(ConstMatrixView a, double value, MatrixView out)
+{
+    if(out.rows() != a.rows() || out.cols() != a.cols())
+        throw std::runtime_error("Matice musi mit stejnou velikost.");
+
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+
+    for(size_t r = 0; r < a.rows(); r++)
+    {
+        kernels.scale(a.cols(), value, a.data() + r * a.stride(), out.data() + r * out.stride());
+    }
+}
+
+void multiply(ConstMatrixView a, ConstMatrixView b, MatrixView out, MultiplyPolicy policy)
+{
+    if(a.cols() != b.rows())
+        throw std::runtime_error("Prvni matice musi stejny pocet sloupcu jako druha radku.");
+
+    if(out.rows() != a.rows() || out.cols() != b.cols())
+        throw std::runtime_error("Vystup nasobeni musi mit velikost a.rows() x b.cols().");
+
+    if(overlaps(a, out) || overlaps(b, out))
+        throw std::runtime_error("Vystup nasobeni se nesmi prekryvat s cinitely.");
+
+    // beta = 0: gemm C necte, puvodni obsah (i NaN) se neprojevi
+    if(policy == MULTIPLY_CLASSIC)
+    {
+        MatrixKernels::gemmParallel(nullptr, a.rows(), b.cols(), a.cols(), 1.0, a.data(), a.stride(),
+                                    b.data(), b.stride(), 0.0, out.data(), out.stride());
+    }
+    else
+    {
+        MatrixKernels::gemmStrassen(nullptr, a.rows(), b.cols(), a.cols(), a.data(), a.stride(),
+                                    b.data(), b.stride(), out.data(), out.stride());
+    }
+}
+
+void multiply(ConstMatrixView a, const double *x, double *y)
+{
+    MatrixKernels::gemv(nullptr, MatrixKernels::NO_TRANS, a.rows(), a.cols(), 1.0,
+                        a.data(), a.stride(), x, 0.0, y);
+}
+
+void multiplyTransposed(ConstMatrixView a, const double *x, double *y)
+{
+    MatrixKernels::gemv(nullptr, MatrixKernels::TRANS, a.rows(), a.cols(), 1.0,
+                        a.data(), a.stride(), x, 0.0, y);
+}
+
+double determinant(ConstMatrixView a)
+{
+    if(a.rows() != a.cols())
+        throw std::runtime_error("Matice musi byt ctvercova.");
+
+    const double *d = a.data();
+    const size_t s = a.stride();
+
+    if(a.rows() == 1)
+    {
+        return d[0];
+    }
+    else if(a.rows() == 2)
+    {
+        return d[0]*d[s + 1] - d[s]*d[1];
+    }
+    else if(a.rows() == 3)
+    {
+        return d[0]*d[s + 1]*d[2*s + 2] +
+            d[1]*d[s + 2]*d[2*s] +
+            d[2]*d[s]*d[2*s + 1] -
+            d[2*s]*d[s + 1]*d[2] -
+            d[2*s + 1]*d[s + 2]*d[0] -
+            d[2*s + 2]*d[1]*d[s];
+    }
+
+    // Rozklad probiha na miste, pracovni kopie je nutna
+    Matrix lu(a);
+    std::vector<size_t> pivots(lu.rows());
+
+    if(!MatrixKernels::getrf(lu.rows(), lu.data(), lu.stride(), pivots.data(), 0.0))
+        return 0;
+
+    double det = 1;
+
+    for(size_t k = 0; k < lu.rows(); k++)
+    {
+        det *= lu.data()[k * lu.stride() + k];
+
+        if(pivots[k] != k)
+            det = -det;
+    }
+
+    return det;
+}
+
+std::vector<double> solveEquation(ConstMatrixView a, const std::vector<double> &b)
+{
+    if(a.cols() != b.size())
+        throw std::runtime_error("Pocet prvku prave strany rovnice musi odpovidat poctu radku matice.");
+
+    return Factorization(a).solve(b);
+}
+
+/*** Konec souboru matrix_view.cpp ***/
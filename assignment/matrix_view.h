@@ -0,0 +1,257 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - non-owning strided matrix views
+//
+// $NoKeywords: $ivs_project_1 $matrix_view.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file matrix_view.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Pohledy na cast matice (radek, sloupec, blok), ktere nevlastni
+ *        data. Pohled je dan ukazatelem na prvni prvek, poctem radku,
+ *        sloupcu a vzdalenosti radku (stride), vytvoreni pohledu tedy nic
+ *        nekopiruje ani nealokuje. Pohled nesmi prezit matici, na kterou
+ *        odkazuje.
+ */
+
+#pragma once
+
+#ifndef MATRIX_VIEW_H_
+#define MATRIX_VIEW_H_
+
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "white_box_code.h"
+
+/**
+ * @brief Pohled na obdelnikovou cast matice ulozene po radcich
+ * T je typ prvku matice (double nebo float), pohled na const T umoznuje
+ * pouze cteni.
+ */
+template<class T>
+class BasicMatrixView
+{
+public:
+  typedef typename std::remove_const<T>::type ValueType;
+  typedef typename std::conditional<std::is_const<T>::value, const BasicMatrix<ValueType>,
+                                    BasicMatrix<ValueType> >::type MatrixType;
+
+  /**
+   * @brief BasicMatrixView
+   * Konstruktor vytvori pohled nad libovolnym polem
+   *
+   * @param      data    ukazatel na prvek [0][0]
+   * @param      rows    pocet radku
+   * @param      cols    pocet sloupcu
+   * @param      stride  vzdalenost (v prvcich) mezi zacatky radku
+   */
+  BasicMatrixView(T *data, size_t rows, size_t cols, size_t stride):
+    mData(data), mRows(rows), mCols(cols), mStride(stride) {}
+
+  /**
+   * @brief BasicMatrixView
+   * Pohled na celou matici
+   */
+  BasicMatrixView(MatrixType &m):
+    mData(m.data()), mRows(m.rows()), mCols(m.cols()), mStride(m.stride()) {}
+
+  /**
+   * @brief BasicMatrixView
+   * Prevod zapisovatelneho pohledu na pohled pouze pro cteni
+   */
+  template<class U>
+  BasicMatrixView(const BasicMatrixView<U> &other,
+                  typename std::enable_if<std::is_convertible<U *, T *>::value>::type * = nullptr):
+    mData(other.data()), mRows(other.rows()), mCols(other.cols()), mStride(other.stride()) {}
+
+  size_t rows() const { return mRows; }
+
+  size_t cols() const { return mCols; }
+
+  size_t stride() const { return mStride; }
+
+  T *data() const { return mData; }
+
+  /**
+   * @brief      get
+   *      * vrati hodnotu na pozici row, col pohledu
+   */
+  ValueType get(size_t row, size_t col) const
+  {
+    if(row >= mRows || col >= mCols)
+      throw std::runtime_error("Pristup k indexu mimo matici");
+
+    return mData[row * mStride + col];
+  }
+
+  /**
+   * @brief      set
+   *      * nastavi hodnotu na pozici row, col pohledu (a tedy i matice)
+   *
+   * @return     pokud bylo vlozeni uspesne vrati true, jinak false
+   */
+  bool set(size_t row, size_t col, ValueType value) const
+  {
+    if(row >= mRows || col >= mCols)
+      return false;
+
+    mData[row * mStride + col] = value;
+
+    return true;
+  }
+
+  /**
+   * @brief      block
+   *      * pohled na blok rows x cols zacinajici na pozici row, col
+   */
+  BasicMatrixView block(size_t row, size_t col, size_t rows, size_t cols) const
+  {
+    if(row > mRows || col > mCols || rows > mRows - row || cols > mCols - col || rows == 0 || cols == 0)
+      throw std::runtime_error("Pristup k indexu mimo matici");
+
+    return BasicMatrixView(mData + row * mStride + col, rows, cols, mStride);
+  }
+
+  /**
+   * @brief      pohled na jeden radek
+   */
+  BasicMatrixView row(size_t row) const { return block(row, 0, 1, mCols); }
+
+  /**
+   * @brief      pohled na jeden sloupec
+   */
+  BasicMatrixView col(size_t col) const { return block(0, col, mRows, 1); }
+
+  /**
+   * @brief      assign
+   *      * prepise prvky pohledu hodnotami ze zdroje stejne velikosti
+   *
+   * @param      source  zdroj (nesmi se castecne prekryvat s pohledem)
+   */
+  template<class U>
+  void assign(const BasicMatrixView<U> &source) const
+  {
+    if(source.rows() != mRows || source.cols() != mCols)
+      throw std::runtime_error("Matice musi mit stejnou velikost.");
+
+    for(size_t r = 0; r < mRows; r++)
+    {
+      for(size_t c = 0; c < mCols; c++)
+        mData[r * mStride + c] = source.data()[r * source.stride() + c];
+    }
+  }
+
+protected:
+  T *mData;
+  size_t mRows;
+  size_t mCols;
+  size_t mStride;
+};
+
+typedef BasicMatrixView<double> MatrixView;
+typedef BasicMatrixView<const double> ConstMatrixView;
+typedef BasicMatrixView<float> MatrixViewF;
+typedef BasicMatrixView<const float> ConstMatrixViewF;
+
+/**
+ * @brief      porovnani
+ *        * porovna prvky dvou stejne velkych pohledu
+ */
+bool operator==(ConstMatrixView a, ConstMatrixView b);
+
+/**
+ * @brief      scitani
+ *        * secte dva pohledy (nebo pohled a matici)
+ */
+Matrix operator+(ConstMatrixView a, ConstMatrixView b);
+
+/**
+ * @brief      nasobeni
+ *        * vynasobi dva pohledy, blokovy GEMM cte data primo z puvodnich
+ *          matic
+ */
+Matrix operator*(ConstMatrixView a, ConstMatrixView b);
+
+/**
+ * @brief      nasobeni zvolenym algoritmem
+ *        * MULTIPLY_STRASSEN je rychlejsi pro velke matice, ale ma horsi
+ *          chybovou mez (viz MatrixKernels::gemmStrassen), proto se
+ *          nikdy nepouziva automaticky
+ *
+ * @param      a, b    cinitele
+ * @param      policy  algoritmus nasobeni
+ *
+ * @return     vysledna matice po vynasobeni matic
+ */
+Matrix multiply(ConstMatrixView a, ConstMatrixView b, MultiplyPolicy policy);
+
+/**
+ * @brief      skalarni nasobeni
+ */
+Matrix operator*(ConstMatrixView a, double value);
+
+/**
+ * @brief      scitani do vystupu
+ *        * out = a + b bez alokace, out muze byt primo a nebo b
+ *
+ * @param      out   vystup stejne velikosti jako a a b
+ */
+void add(ConstMatrixView a, ConstMatrixView b, MatrixView out);
+
+/**
+ * @brief      skalarni nasobeni do vystupu
+ *        * out = value * a bez alokace, out muze byt primo a
+ */
+void multiply(ConstMatrixView a, double value, MatrixView out);
+
+/**
+ * @brief      nasobeni do vystupu
+ *        * out = a * b bez alokace vysledku, puvodni obsah out se necte
+ *          (neni potreba jej nulovat). Vhodne pro opakovane soucitny
+ *          v iteracnich smyckach s predem alokovanym vystupem.
+ *
+ * @param      a, b    cinitele
+ * @param      out     vystup a.rows() x b.cols(), nesmi se prekryvat
+ *                     s a ani b
+ * @param      policy  algoritmus nasobeni (viz multiply vyse)
+ */
+void multiply(ConstMatrixView a, ConstMatrixView b, MatrixView out,
+              MultiplyPolicy policy = MULTIPLY_CLASSIC);
+
+/**
+ * @brief      nasobeni vektorem do vystupu
+ *        * y = a x bez alokace (MatrixKernels::gemv)
+ *
+ * @param      x     vstup delky a.cols()
+ * @param      y     vystup delky a.rows(), nesmi se prekryvat s a ani x
+ */
+void multiply(ConstMatrixView a, const double *x, double *y);
+
+/**
+ * @brief      nasobeni transponovanym pohledem do vystupu
+ *        * y = a^T x bez alokace a bez transpozice a
+ *
+ * @param      x     vstup delky a.rows()
+ * @param      y     vystup delky a.cols(), nesmi se prekryvat s a ani x
+ */
+void multiplyTransposed(ConstMatrixView a, const double *x, double *y);
+
+/**
+ * @brief      determinant
+ *        * determinant ctvercoveho pohledu, rady 1 az 3 bez alokace
+ */
+double determinant(ConstMatrixView a);
+
+/**
+ * @brief      reseni spoustavy linearnich rovnic a x = b
+ */
+std::vector<double> solveEquation(ConstMatrixView a, const std::vector<double> &b);
+
+#endif /* MATRIX_VIEW_H_ */
+
+/*** Konec souboru matrix_view.h ***/
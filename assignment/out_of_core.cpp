@@ -0,0 +1,189 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - out-of-core matrix multiplication
+//
+// $NoKeywords: $ivs_project_1 $out_of_core.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file out_of_core.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Dlazdicove nasobeni matic ze souboru s dvojitym bufferovanim
+ *        vstupu (std::async) nad jadrem MatrixKernels::gemmParallel.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+
+#include "out_of_core.h"
+#include "matrix_file.h"
+#include "thread_pool.h"
+
+namespace OutOfCore
+{
+  /**
+   * Zaokrouhleni poctu prvku nahoru na cely radek cache
+   */
+  static size_t alignElems(size_t count)
+  {
+    return (count + MATRIX_ALIGN_ELEMS - 1) / MATRIX_ALIGN_ELEMS * MATRIX_ALIGN_ELEMS;
+  }
+
+  /**
+   * Pamet dlazdice rows x cols ulozene jako Matrix
+   */
+  static size_t tileBytes(size_t rows, size_t cols)
+  {
+    return rows * alignElems(cols) * sizeof(double);
+  }
+
+  /**
+   * Odhad pameti pro dlazdice mb x kb, kb x nb a mb x nb: jedna dlazdice C,
+   * dva pary dlazdic A a B a zabalene bloky gemm v kazdem vlakne
+   */
+  static size_t memoryEstimate(size_t mb, size_t nb, size_t kb, size_t workers)
+  {
+    using namespace MatrixKernels;
+
+    size_t kc = std::min(kb, GEMM_KC);
+    size_t packA = (std::min(mb, GEMM_MC) + GEMM_MR - 1) / GEMM_MR * GEMM_MR * kc;
+    size_t packB = (std::min(nb, GEMM_NC) + GEMM_NR - 1) / GEMM_NR * GEMM_NR * kc;
+
+    return tileBytes(mb, nb) + 2 * (tileBytes(mb, kb) + tileBytes(kb, nb)) +
+           workers * (packA + packB) * sizeof(double);
+  }
+
+  /**
+   * Nacte blok rows x cols zacinajici na [r0][c0] souboru do dlazdice
+   */
+  static void readTile(std::ifstream &in, const MatrixFileHeader &h, size_t r0, size_t c0,
+                       size_t rows, size_t cols, Matrix &tile)
+  {
+    for(size_t r = 0; r < rows; r++)
+    {
+      in.seekg(h.dataOffset + ((r0 + r) * h.stride + c0) * sizeof(double));
+      in.read(reinterpret_cast<char *>(tile.data() + r * tile.stride()), cols * sizeof(double));
+    }
+
+    if(!in)
+      throw std::runtime_error("Soubor matice nelze cist.");
+  }
+
+  /**
+   * Zapise blok rows x cols dlazdice do souboru od pozice [r0][c0]
+   */
+  static void writeTile(std::fstream &out, const MatrixFileHeader &h, size_t r0, size_t c0,
+                        size_t rows, size_t cols, const Matrix &tile)
+  {
+    for(size_t r = 0; r < rows; r++)
+    {
+      out.seekp(h.dataOffset + ((r0 + r) * h.stride + c0) * sizeof(double));
+      out.write(reinterpret_cast<const char *>(tile.data() + r * tile.stride()), cols * sizeof(double));
+    }
+
+    if(!out)
+      throw std::runtime_error("Soubor matice nelze zapsat.");
+  }
+
+  void multiply(const std::string &pathA, const std::string &pathB, const std::string &pathC,
+                const Options &options, Stats &stats)
+  {
+    if(pathC == pathA || pathC == pathB)
+      throw std::runtime_error("Soubor vysledku nesmi byt totozny s operandem.");
+
+    const MatrixFileHeader ha = readMatrixFileHeader(pathA);
+    const MatrixFileHeader hb = readMatrixFileHeader(pathB);
+
+    if(ha.dtype != MATRIX_FILE_F64 || hb.dtype != MATRIX_FILE_F64)
+      throw std::runtime_error("Nasobeni souboru podporuje pouze matice typu double.");
+
+    if(ha.cols != hb.rows)
+      throw std::runtime_error("Prvni matice musi stejny pocet sloupcu jako druha radku.");
+
+    const size_t m = ha.rows, k = ha.cols, n = hb.cols;
+    ThreadPool *pool = options.pool != nullptr ? options.pool : &ThreadPool::shared();
+    // Na dokonceni uloh ceka i volajici vlakno a pritom je samo vykonava
+    const size_t workers = pool->size() + 1;
+
+    size_t t = alignElems(std::max(m, std::max(n, k)));
+
+    if(options.maxTile > 0)
+      t = std::min(t, std::max<size_t>(options.maxTile / MATRIX_ALIGN_ELEMS, 1) * MATRIX_ALIGN_ELEMS);
+
+    while(t > MATRIX_ALIGN_ELEMS &&
+          memoryEstimate(std::min(t, m), std::min(t, n), std::min(t, k), workers) > options.memoryBudget)
+      t -= MATRIX_ALIGN_ELEMS;
+
+    const size_t mb = std::min(t, m), nb = std::min(t, n), kb = std::min(t, k);
+
+    stats.tile = t;
+    stats.peakBytes = memoryEstimate(mb, nb, kb, workers);
+    stats.tilesRead = 0;
+
+    if(stats.peakBytes > options.memoryBudget)
+      throw std::runtime_error("Pametovy rozpocet je pro nasobeni prilis maly.");
+
+    std::ifstream inA(pathA.c_str(), std::ios::binary);
+    std::ifstream inB(pathB.c_str(), std::ios::binary);
+
+    if(!inA || !inB)
+      throw std::runtime_error("Soubor matice nelze otevrit.");
+
+    const MatrixFileHeader hc = createMatrixFile(pathC, m, n);
+    std::fstream outC(pathC.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+
+    if(!outC)
+      throw std::runtime_error("Soubor matice nelze otevrit pro zapis.");
+
+    const size_t tilesM = (m + mb - 1) / mb, tilesN = (n + nb - 1) / nb, tilesK = (k + kb - 1) / kb;
+    const size_t steps = tilesM * tilesN * tilesK;
+
+    Matrix c(mb, nb);
+    Matrix a[2] = { Matrix(mb, kb), Matrix(mb, kb) };
+    Matrix b[2] = { Matrix(kb, nb), Matrix(kb, nb) };
+
+    // Krok s pocita prispevek A(i, p) B(p, j) k dlazdici C(i, j), p se meni
+    // nejrychleji. Dlazdice kroku s jsou v bufferech s % 2.
+    auto load = [&](size_t s) {
+      size_t p = s % tilesK, j = s / tilesK % tilesN, i = s / tilesK / tilesN;
+      size_t rows = std::min(mb, m - i * mb), cols = std::min(nb, n - j * nb), depth = std::min(kb, k - p * kb);
+
+      readTile(inA, ha, i * mb, p * kb, rows, depth, a[s % 2]);
+      readTile(inB, hb, p * kb, j * nb, depth, cols, b[s % 2]);
+    };
+
+    // Future z std::async pri zaniku ceka na dokonceni cteni, buffery
+    // deklarovane drive proto nezaniknou pred nim ani pri vyjimce
+    std::future<void> pending = std::async(std::launch::async, load, 0);
+
+    for(size_t s = 0; s < steps; s++)
+    {
+      pending.get();
+      stats.tilesRead += 2;
+
+      if(s + 1 < steps)
+        pending = std::async(std::launch::async, load, s + 1);
+
+      size_t p = s % tilesK, j = s / tilesK % tilesN, i = s / tilesK / tilesN;
+      size_t rows = std::min(mb, m - i * mb), cols = std::min(nb, n - j * nb), depth = std::min(kb, k - p * kb);
+      const Matrix &ta = a[s % 2], &tb = b[s % 2];
+
+      MatrixKernels::gemmParallel(pool, rows, cols, depth, 1.0, ta.data(), ta.stride(),
+                                  tb.data(), tb.stride(), p == 0 ? 0.0 : 1.0, c.data(), c.stride());
+
+      if(p + 1 == tilesK)
+        writeTile(outC, hc, i * mb, j * nb, rows, cols, c);
+    }
+
+    outC.close();
+
+    if(!outC)
+      throw std::runtime_error("Soubor matice nelze zapsat.");
+  }
+}
+
+/*** Konec souboru out_of_core.cpp ***/
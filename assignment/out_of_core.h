@@ -0,0 +1,98 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - out-of-core matrix multiplication
+//
+// $NoKeywords: $ivs_project_1 $out_of_core.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file out_of_core.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Nasobeni matic ulozenych v binarnich souborech (matrix_file.h),
+ *        ktere se nevejdou do pameti. Soucin se pocita po dlazdicich,
+ *        v pameti jsou vzdy jen dlazdice vysledku a dva pary dlazdic
+ *        operandu: zatimco se pocita s jednim parem, druhy se nacita
+ *        ve vlakne pro vstup/vystup.
+ */
+
+#pragma once
+
+#ifndef OUT_OF_CORE_H_
+#define OUT_OF_CORE_H_
+
+#include <cstddef>
+#include <string>
+
+class ThreadPool;
+
+namespace OutOfCore
+{
+  /**
+   * @brief Nastaveni nasobeni
+   */
+  struct Options
+  {
+    /**
+     * Nejvyssi pamet v bajtech pro dlazdice a pracovni pamet gemm vsech
+     * vlaken (baleni bloku, viz MatrixKernels::gemm)
+     */
+    size_t memoryBudget = size_t(1) << 30;
+
+    /**
+     * Nejvetsi rozmer dlazdice, 0 znamena omezeni jen pameti
+     */
+    size_t maxTile = 0;
+
+    /**
+     * Fond vlaken pro vypocet dlazdic (nullptr = ThreadPool::shared())
+     */
+    ThreadPool *pool = nullptr;
+  };
+
+  /**
+   * @brief Prubeh nasobeni
+   */
+  struct Stats
+  {
+    /**
+     * Rozmer pouzitych ctvercovych dlazdic (okrajove mohou byt mensi)
+     */
+    size_t tile = 0;
+
+    /**
+     * Odhad nejvyssi pameti (dlazdice a pracovni pamet gemm), vzdy
+     * nejvyse Options::memoryBudget
+     */
+    size_t peakBytes = 0;
+
+    /**
+     * Pocet nactenych dlazdic operandu
+     */
+    size_t tilesRead = 0;
+  };
+
+  /**
+   * @brief      multiply
+   *        * C = A B pro matice typu double v binarnich souborech. Dlazdice
+   *          C t x t se pocita v pameti pres vsechny dlazdice A a B
+   *          (gemmParallel s beta = 1) a zapise se jednou. Dalsi par
+   *          dlazdic A a B se nacita asynchronne behem vypoctu s aktualnim.
+   *          Rozmer t je nejvetsi nasobek MATRIX_ALIGN_ELEMS, pri kterem se
+   *          pamet vejde do rozpoctu. Pri chybe vstupu/vystupu, spatnych
+   *          rozmerech nebo prilis malem rozpoctu vyhodi std::runtime_error.
+   *
+   * @param      pathA, pathB   soubory operandu
+   * @param      pathC          soubor vysledku (vytvori se nebo prepise,
+   *                            nesmi byt totozny s operandem)
+   * @param      options        nastaveni
+   * @param      stats          prubeh nasobeni
+   */
+  void multiply(const std::string &pathA, const std::string &pathB, const std::string &pathC,
+                const Options &options, Stats &stats);
+}
+
+#endif /* OUT_OF_CORE_H_ */
+
+/*** Konec souboru out_of_core.h ***/
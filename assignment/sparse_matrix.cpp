@@ -0,0 +1,320 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - compressed sparse matrix
+//
+// $NoKeywords: $ivs_project_1 $sparse_matrix.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file sparse_matrix.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Definice metod ridke matice a jader SpMV a SpMM.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "sparse_matrix.h"
+#include "thread_pool.h"
+
+/**
+ * Minimalni pocet nenul, od ktereho se nasobeni vyplati delit mezi vlakna
+ */
+static const size_t SPARSE_PARALLEL_MIN = 1 << 15;
+
+/**
+ * Sirka pruhu sloupcu husteho vysledku na jednu ulohu pri nasobeni CSC
+ */
+static const size_t SPARSE_DENSE_STRIP = 256;
+
+SparseMatrix::SparseMatrix(size_t rows, size_t cols, Format format):
+    mRows(rows), mCols(cols), mFormat(format)
+{
+    if(rows < 1 || cols < 1)
+        throw std::runtime_error("Minimalni velikost matice je 1x1");
+
+    mPointers.assign(outer() + 1, 0);
+}
+
+SparseMatrix::SparseMatrix(size_t rows, size_t cols, const std::vector<Triplet> &triplets, Format format):
+    SparseMatrix(rows, cols, format)
+{
+    std::vector<std::pair<size_t, double> > entries(triplets.size());
+    std::vector<size_t> next(outer() + 1, 0);
+
+    for(size_t i = 0; i < triplets.size(); i++)
+    {
+        if(triplets[i].row >= mRows || triplets[i].col >= mCols)
+            throw std::runtime_error("Pristup k indexu mimo matici");
+
+        next[(mFormat == CSR ? triplets[i].row : triplets[i].col) + 1]++;
+    }
+
+    for(size_t o = 0; o < outer(); o++)
+        next[o + 1] += next[o];
+
+    std::vector<size_t> start(next);
+
+    // Rozrazeni podle vnejsiho indexu (counting sort)
+    for(size_t i = 0; i < triplets.size(); i++)
+    {
+        const Triplet &t = triplets[i];
+        size_t o = mFormat == CSR ? t.row : t.col;
+
+        entries[next[o]++] = std::make_pair(mFormat == CSR ? t.col : t.row, t.value);
+    }
+
+    mIndices.reserve(entries.size());
+    mValues.reserve(entries.size());
+
+    for(size_t o = 0; o < outer(); o++)
+    {
+        std::sort(entries.begin() + start[o], entries.begin() + start[o + 1]);
+
+        for(size_t i = start[o]; i < start[o + 1]; i++)
+        {
+            if(i > start[o] && entries[i].first == mIndices.back())
+                mValues.back() += entries[i].second;
+            else
+            {
+                mIndices.push_back(entries[i].first);
+                mValues.push_back(entries[i].second);
+            }
+        }
+
+        mPointers[o + 1] = mValues.size();
+    }
+}
+
+SparseMatrix::SparseMatrix(ConstMatrixView dense, Format format, double dropTolerance):
+    SparseMatrix(dense.rows(), dense.cols(), format)
+{
+    for(size_t o = 0; o < outer(); o++)
+    {
+        size_t inner = mFormat == CSR ? mCols : mRows;
+
+        for(size_t i = 0; i < inner; i++)
+        {
+            double value = mFormat == CSR ? dense.data()[o * dense.stride() + i]
+                                          : dense.data()[i * dense.stride() + o];
+
+            if(std::fabs(value) > dropTolerance)
+            {
+                mIndices.push_back(i);
+                mValues.push_back(value);
+            }
+        }
+
+        mPointers[o + 1] = mValues.size();
+    }
+}
+
+double SparseMatrix::get(size_t row, size_t col) const
+{
+    if(row >= mRows || col >= mCols)
+        throw std::runtime_error("Pristup k indexu mimo matici");
+
+    size_t o = mFormat == CSR ? row : col;
+    size_t i = mFormat == CSR ? col : row;
+
+    std::vector<size_t>::const_iterator begin = mIndices.begin() + mPointers[o];
+    std::vector<size_t>::const_iterator end = mIndices.begin() + mPointers[o + 1];
+    std::vector<size_t>::const_iterator found = std::lower_bound(begin, end, i);
+
+    if(found == end || *found != i)
+        return 0;
+
+    return mValues[found - mIndices.begin()];
+}
+
+Matrix SparseMatrix::toDense() const
+{
+    Matrix result(mRows, mCols);
+
+    for(size_t o = 0; o < outer(); o++)
+    {
+        for(size_t p = mPointers[o]; p < mPointers[o + 1]; p++)
+        {
+            if(mFormat == CSR)
+                result.data()[o * result.stride() + mIndices[p]] = mValues[p];
+            else
+                result.data()[mIndices[p] * result.stride() + o] = mValues[p];
+        }
+    }
+
+    return result;
+}
+
+SparseMatrix SparseMatrix::convert(Format format) const
+{
+    if(format == mFormat)
+        return *this;
+
+    SparseMatrix result(mRows, mCols, format);
+    size_t inner = result.outer();
+
+    result.mIndices.resize(nonZeros());
+    result.mValues.resize(nonZeros());
+
+    for(size_t p = 0; p < nonZeros(); p++)
+        result.mPointers[mIndices[p] + 1]++;
+
+    for(size_t i = 0; i < inner; i++)
+        result.mPointers[i + 1] += result.mPointers[i];
+
+    std::vector<size_t> next(result.mPointers.begin(), result.mPointers.end() - 1);
+
+    // Vnejsi indexy se prochazi vzestupne, vysledek je proto uz serazeny
+    for(size_t o = 0; o < outer(); o++)
+    {
+        for(size_t p = mPointers[o]; p < mPointers[o + 1]; p++)
+        {
+            size_t q = next[mIndices[p]]++;
+
+            result.mIndices[q] = o;
+            result.mValues[q] = mValues[p];
+        }
+    }
+
+    return result;
+}
+
+std::vector<size_t> SparseMatrix::partition(size_t parts) const
+{
+    std::vector<size_t> bounds(parts + 1, outer());
+
+    bounds[0] = 0;
+
+    for(size_t t = 1; t < parts; t++)
+    {
+        size_t target = nonZeros() / parts * t;
+
+        bounds[t] = std::upper_bound(mPointers.begin(), mPointers.end(), target) - mPointers.begin() - 1;
+        bounds[t] = std::max(bounds[t], bounds[t - 1]);
+    }
+
+    return bounds;
+}
+
+void SparseMatrix::multiply(ThreadPool *pool, const double *x, double *y) const
+{
+    if(pool == nullptr)
+        pool = &ThreadPool::shared();
+
+    size_t parts = nonZeros() < SPARSE_PARALLEL_MIN ? 1 : std::min(pool->size() * 4, outer());
+    std::vector<size_t> bounds = partition(parts);
+
+    if(mFormat == CSR)
+    {
+        pool->parallelFor(parts, [&](size_t t) {
+            for(size_t r = bounds[t]; r < bounds[t + 1]; r++)
+            {
+                double sum = 0;
+
+                for(size_t p = mPointers[r]; p < mPointers[r + 1]; p++)
+                    sum += mValues[p] * x[mIndices[p]];
+
+                y[r] = sum;
+            }
+        });
+
+        return;
+    }
+
+    // Paralelni CSC by rozptyloval prispevky vsech vlaken do celeho y a
+    // potreboval dilci soucty velikosti parts * rows. Nasobi se proto radkova
+    // kopie, ktera se sestavi jednou pri prvnim pouziti (pamet O(nnz)).
+    if(parts > 1)
+    {
+        std::shared_ptr<const SparseMatrix> rowMajor = std::atomic_load(&mRowMajor);
+
+        if(!rowMajor)
+        {
+            rowMajor = std::make_shared<const SparseMatrix>(convert(CSR));
+            std::atomic_store(&mRowMajor, rowMajor);
+        }
+
+        rowMajor->multiply(pool, x, y);
+        return;
+    }
+
+    std::fill(y, y + mRows, 0.0);
+
+    for(size_t c = 0; c < mCols; c++)
+    {
+        for(size_t p = mPointers[c]; p < mPointers[c + 1]; p++)
+            y[mIndices[p]] += mValues[p] * x[c];
+    }
+}
+
+std::vector<double> SparseMatrix::operator*(const std::vector<double> &x) const
+{
+    if(x.size() != mCols)
+        throw std::runtime_error("Prvni matice musi stejny pocet sloupcu jako druha radku.");
+
+    std::vector<double> y(mRows);
+
+    multiply(nullptr, x.data(), y.data());
+
+    return y;
+}
+
+Matrix SparseMatrix::operator*(ConstMatrixView b) const
+{
+    if(mCols != b.rows())
+        throw std::runtime_error("Prvni matice musi stejny pocet sloupcu jako druha radku.");
+
+    Matrix result(mRows, b.cols());
+    ThreadPool &pool = ThreadPool::shared();
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+    const size_t n = b.cols();
+    const bool parallel = nonZeros() * n >= SPARSE_PARALLEL_MIN;
+
+    if(mFormat == CSR)
+    {
+        // Radek i vysledku je linearni kombinace radku B, radky jsou nezavisle
+        size_t parts = parallel ? std::min(pool.size() * 4, mRows) : 1;
+        std::vector<size_t> bounds = partition(parts);
+
+        pool.parallelFor(parts, [&](size_t t) {
+            for(size_t r = bounds[t]; r < bounds[t + 1]; r++)
+            {
+                double *out = result.data() + r * result.stride();
+
+                for(size_t p = mPointers[r]; p < mPointers[r + 1]; p++)
+                    kernels.fma(n, mValues[p], b.data() + mIndices[p] * b.stride(), out, out);
+            }
+        });
+
+        return result;
+    }
+
+    // CSC pricita do libovolnych radku, vlakna si proto deli sloupce vysledku
+    size_t strips = parallel ? (n + SPARSE_DENSE_STRIP - 1) / SPARSE_DENSE_STRIP : 1;
+
+    pool.parallelFor(strips, [&](size_t s) {
+        size_t begin = n * s / strips / MATRIX_ALIGN_ELEMS * MATRIX_ALIGN_ELEMS;
+        size_t end = s + 1 == strips ? n : n * (s + 1) / strips / MATRIX_ALIGN_ELEMS * MATRIX_ALIGN_ELEMS;
+
+        for(size_t c = 0; c < mCols; c++)
+        {
+            const double *row = b.data() + c * b.stride() + begin;
+
+            for(size_t p = mPointers[c]; p < mPointers[c + 1]; p++)
+            {
+                double *out = result.data() + mIndices[p] * result.stride() + begin;
+
+                kernels.fma(end - begin, mValues[p], row, out, out);
+            }
+        }
+    });
+
+    return result;
+}
+
+/*** Konec souboru sparse_matrix.cpp ***/
@@ -0,0 +1,169 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - compressed sparse matrix
+//
+// $NoKeywords: $ivs_project_1 $sparse_matrix.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file sparse_matrix.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Ridka matice ve formatu CSR (komprimovane radky) nebo CSC
+ *        (komprimovane sloupce). Pamet i cena nasobeni rostou s poctem
+ *        nenulovych prvku, ne s rows * cols.
+ */
+
+#pragma once
+
+#ifndef SPARSE_MATRIX_H_
+#define SPARSE_MATRIX_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "white_box_code.h"
+
+class ThreadPool;
+
+/**
+ * @brief Ridka matice
+ * Ve formatu CSR obsahuje pointers() pro kazdy radek r rozsah
+ * [pointers()[r], pointers()[r + 1]) do poli indices() (sloupce) a values().
+ * Format CSC je totez pro sloupce (indices() jsou pak radky). Indexy jsou
+ * v ramci radku (sloupce) vzestupne a bez duplicit.
+ */
+class SparseMatrix
+{
+public:
+  enum Format
+  {
+    CSR,
+    CSC
+  };
+
+  /**
+   * @brief Nenulovy prvek zadany souradnicemi
+   */
+  struct Triplet
+  {
+    size_t row;
+    size_t col;
+    double value;
+  };
+
+  /**
+   * @brief SparseMatrix
+   * Konstruktor vytvori nulovou ridkou matici velikosti rows x cols
+   */
+  SparseMatrix(size_t rows, size_t cols, Format format = CSR);
+
+  /**
+   * @brief SparseMatrix
+   * Konstruktor vytvori matici z neusporadaneho seznamu prvku, hodnoty
+   * se stejnymi souradnicemi se sectou
+   *
+   * @param      rows      pocet radku
+   * @param      cols      pocet sloupcu
+   * @param      triplets  nenulove prvky
+   * @param      format    format ulozeni
+   */
+  SparseMatrix(size_t rows, size_t cols, const std::vector<Triplet> &triplets, Format format = CSR);
+
+  /**
+   * @brief SparseMatrix
+   * Konstruktor prevede hustou matici, prvky s |a| <= dropTolerance
+   * se neukladaji
+   */
+  explicit SparseMatrix(ConstMatrixView dense, Format format = CSR, double dropTolerance = 0.0);
+
+  size_t rows() const { return mRows; }
+
+  size_t cols() const { return mCols; }
+
+  Format format() const { return mFormat; }
+
+  /**
+   * @brief      pocet ulozenych (nenulovych) prvku
+   */
+  size_t nonZeros() const { return mValues.size(); }
+
+  const std::vector<size_t> &pointers() const { return mPointers; }
+
+  const std::vector<size_t> &indices() const { return mIndices; }
+
+  const std::vector<double> &values() const { return mValues; }
+
+  /**
+   * @brief      get
+   *      * vrati hodnotu na pozici row, col (binarni vyhledani, O(log nnz))
+   */
+  double get(size_t row, size_t col) const;
+
+  /**
+   * @brief      prevod na hustou matici
+   */
+  Matrix toDense() const;
+
+  /**
+   * @brief      prevod do jineho formatu v O(rows + cols + nnz)
+   */
+  SparseMatrix convert(Format format) const;
+
+  /**
+   * @brief      nasobeni vektorem (SpMV) y = A x
+   *        * CSR je rozdelen mezi vlakna po radcich s priblizne stejnym
+   *          poctem nenul. CSC se v jednom vlakne pocita primo po
+   *          sloupcich, paralelne pres radkovou kopii (convert(CSR)), ktera
+   *          se sestavi pri prvnim paralelnim nasobeni a dale se pouziva
+   *
+   * @param      pool  fond vlaken (nullptr = ThreadPool::shared())
+   * @param      x     vstup delky cols()
+   * @param      y     vystup delky rows(), nesmi se prekryvat s x
+   */
+  void multiply(ThreadPool *pool, const double *x, double *y) const;
+
+  /**
+   * @brief      nasobeni vektorem y = A x
+   */
+  std::vector<double> operator*(const std::vector<double> &x) const;
+
+  /**
+   * @brief      nasobeni hustou matici C = A B
+   *        * cena O(nnz * B.cols()), radky B se pricitaji prvkovymi jadry
+   */
+  Matrix operator*(ConstMatrixView b) const;
+
+protected:
+  size_t mRows;
+  size_t mCols;
+  Format mFormat;
+
+  std::vector<size_t> mPointers;
+  std::vector<size_t> mIndices;
+  std::vector<double> mValues;
+
+  /**
+   * Kopie matice CSC ve formatu CSR pro paralelni SpMV (sestavuje se
+   * az pri prvnim pouziti, pristup pres std::atomic_load/atomic_store)
+   */
+  mutable std::shared_ptr<const SparseMatrix> mRowMajor;
+
+  /**
+   * @brief      delka vnejsi dimenze (radky pro CSR, sloupce pro CSC)
+   */
+  size_t outer() const { return mFormat == CSR ? mRows : mCols; }
+
+  /**
+   * @brief      rozdeli vnejsi dimenzi na parts casti s podobnym poctem nenul
+   *
+   * @return     hranice casti (parts + 1 hodnot)
+   */
+  std::vector<size_t> partition(size_t parts) const;
+};
+
+#endif /* SPARSE_MATRIX_H_ */
+
+/*** Konec souboru sparse_matrix.h ***/
@@ -0,0 +1,271 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - dependency-driven task graph scheduler
+//
+// $NoKeywords: $ivs_project_1 $task_graph.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file task_graph.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Vykonavani grafu uloh s kradenim prace a zaznam jeho prubehu.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include "task_graph.h"
+#include "thread_pool.h"
+
+TaskGraph::TaskId TaskGraph::add(const std::string &name, std::function<void()> body)
+{
+    Task task;
+    task.name = name;
+    task.body = std::move(body);
+    task.prerequisites = 0;
+
+    mTasks.push_back(std::move(task));
+
+    return mTasks.size() - 1;
+}
+
+void TaskGraph::depend(TaskId task, TaskId prerequisite)
+{
+    if(task >= mTasks.size() || prerequisite >= task)
+        throw std::runtime_error("Zavislost musi vest od drive pridane ulohy.");
+
+    mTasks[prerequisite].successors.push_back(task);
+    mTasks[task].prerequisites++;
+}
+
+void TaskGraph::run(ThreadPool &pool, TaskTrace *trace)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * Fronta pripravenych uloh jednoho vlakna grafu
+     */
+    struct Queue
+    {
+        std::mutex lock;
+        std::deque<TaskId> ready;
+    };
+
+    const size_t workers = pool.size();
+    const size_t count = mTasks.size();
+
+    std::vector<std::unique_ptr<Queue> > queues;
+    std::unique_ptr<std::atomic<size_t>[]> waiting(new std::atomic<size_t>[count]);
+    std::vector<std::vector<TaskTrace::Event> > events(workers);
+
+    // Pocet pripravenych uloh ve frontach a dosud nedokoncenych uloh,
+    // oboji chranene sleepLock pri zvysovani, resp. snizovani na nulu
+    std::atomic<size_t> pending(0);
+    std::atomic<size_t> remaining(count);
+    std::atomic<bool> stop(false);
+    std::exception_ptr error;
+    std::mutex sleepLock;
+    std::condition_variable wake;
+
+    for(size_t w = 0; w < workers; w++)
+        queues.push_back(std::unique_ptr<Queue>(new Queue()));
+
+    for(TaskId id = 0; id < count; id++)
+        waiting[id] = mTasks[id].prerequisites;
+
+    // Ulohy bez zavislosti se rozdeli mezi fronty po rade
+    for(TaskId id = 0, next = 0; id < count; id++)
+    {
+        if(mTasks[id].prerequisites == 0)
+        {
+            queues[next++ % workers]->ready.push_front(id);
+            pending++;
+        }
+    }
+
+    const Clock::time_point begin = Clock::now();
+
+    auto seconds = [&begin]() {
+        return std::chrono::duration<double>(Clock::now() - begin).count();
+    };
+
+    auto take = [&](size_t self, TaskId &id) {
+        for(size_t i = 0; i < workers; i++)
+        {
+            Queue &queue = *queues[(self + i) % workers];
+            std::lock_guard<std::mutex> guard(queue.lock);
+
+            if(queue.ready.empty())
+                continue;
+
+            // Z vlastni fronty nejnovejsi ulohu, z cizich nejstarsi
+            if(i == 0)
+            {
+                id = queue.ready.back();
+                queue.ready.pop_back();
+            }
+            else
+            {
+                id = queue.ready.front();
+                queue.ready.pop_front();
+            }
+
+            pending--;
+            return true;
+        }
+
+        return false;
+    };
+
+    std::function<void(size_t)> worker = [&](size_t self) {
+        std::vector<TaskId> released;
+
+        while(!stop)
+        {
+            TaskId id;
+
+            if(!take(self, id))
+            {
+                std::unique_lock<std::mutex> lock(sleepLock);
+                wake.wait(lock, [&] { return stop || remaining == 0 || pending > 0; });
+
+                if(remaining == 0)
+                    return;
+
+                continue;
+            }
+
+            Task &task = mTasks[id];
+            double start = trace != nullptr ? seconds() : 0;
+
+            try
+            {
+                task.body();
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                if(!error)
+                    error = std::current_exception();
+                stop = true;
+                wake.notify_all();
+                return;
+            }
+
+            if(trace != nullptr)
+            {
+                TaskTrace::Event event = { task.name, self, start, seconds() };
+                events[self].push_back(event);
+            }
+
+            released.clear();
+
+            for(size_t i = 0; i < task.successors.size(); i++)
+            {
+                if(--waiting[task.successors[i]] == 0)
+                    released.push_back(task.successors[i]);
+            }
+
+            // Vlastni vlakno bere z konce fronty, uvolnene ulohy se proto
+            // vkladaji v obracenem poradi (prvni pridana se vykona prvni)
+            if(!released.empty())
+            {
+                std::lock_guard<std::mutex> guard(queues[self]->lock);
+                queues[self]->ready.insert(queues[self]->ready.end(), released.rbegin(), released.rend());
+            }
+
+            bool finished;
+            {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                pending += released.size();
+                finished = --remaining == 0;
+            }
+
+            if(finished)
+                wake.notify_all();
+            else
+            {
+                // Jednu z uvolnenych uloh vykona toto vlakno samo
+                for(size_t i = 1; i < released.size(); i++)
+                    wake.notify_one();
+            }
+        }
+    };
+
+    pool.parallelFor(workers, worker);
+
+    if(error)
+        std::rethrow_exception(error);
+
+    if(trace != nullptr)
+    {
+        trace->workers = workers;
+        trace->makespan = seconds();
+        trace->events.clear();
+
+        for(size_t w = 0; w < workers; w++)
+            trace->events.insert(trace->events.end(), events[w].begin(), events[w].end());
+
+        std::sort(trace->events.begin(), trace->events.end(),
+                  [](const TaskTrace::Event &a, const TaskTrace::Event &b) { return a.start < b.start; });
+    }
+}
+
+double TaskTrace::utilization() const
+{
+    if(workers == 0 || makespan <= 0)
+        return 0;
+
+    double busy = 0;
+
+    for(size_t i = 0; i < events.size(); i++)
+        busy += events[i].end - events[i].start;
+
+    return std::min(busy / (workers * makespan), 1.0);
+}
+
+void TaskTrace::writeChromeTrace(std::ostream &out) const
+{
+    out << "{\"traceEvents\":[";
+
+    for(size_t i = 0; i < events.size(); i++)
+    {
+        const Event &e = events[i];
+
+        out << (i > 0 ? ",\n" : "\n") << "{\"name\":\"";
+
+        for(size_t c = 0; c < e.name.size(); c++)
+        {
+            if(e.name[c] == '"' || e.name[c] == '\\')
+                out << '\\';
+            out << e.name[c];
+        }
+
+        // Casy jsou v mikrosekundach
+        out << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << e.worker
+            << ",\"ts\":" << e.start * 1e6 << ",\"dur\":" << (e.end - e.start) * 1e6 << "}";
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void TaskTrace::writeText(std::ostream &out) const
+{
+    for(size_t i = 0; i < events.size(); i++)
+    {
+        const Event &e = events[i];
+
+        out << e.worker << ' ' << e.start * 1e6 << ' ' << e.end * 1e6 << ' ' << e.name << '\n';
+    }
+}
+
+/*** Konec souboru task_graph.cpp ***/
@@ -0,0 +1,161 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - dependency-driven task graph scheduler
+//
+// $NoKeywords: $ivs_project_1 $task_graph.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file task_graph.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Acyklicky graf uloh (DAG) s planovanim rizenym zavislostmi.
+ *        Uloha se spusti, jakmile skonci vsechny ulohy, na kterych zavisi,
+ *        bez spolecnych barier mezi kroky algoritmu.
+ */
+
+#pragma once
+
+#ifndef TASK_GRAPH_H_
+#define TASK_GRAPH_H_
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Zaznam prubehu grafu uloh
+ * Pro kazdou spustenou ulohu uchova vlakno a cas zacatku a konce, z cehoz
+ * lze posoudit vytizeni jader (utilization) nebo rozvrh zobrazit
+ * v prohlizeci (writeChromeTrace, chrome://tracing nebo Perfetto).
+ */
+struct TaskTrace
+{
+  /**
+   * @brief Jedna vykonana uloha
+   */
+  struct Event
+  {
+    std::string name;   ///< jmeno ulohy
+    size_t worker;      ///< index vlakna grafu, ktere ulohu vykonalo
+    double start;       ///< zacatek v sekundach od spusteni grafu
+    double end;         ///< konec v sekundach od spusteni grafu
+  };
+
+  /**
+   * Ulohy serazene podle zacatku
+   */
+  std::vector<Event> events;
+
+  /**
+   * Pocet vlaken, ktera graf vykonavala
+   */
+  size_t workers = 0;
+
+  /**
+   * Doba behu celeho grafu v sekundach
+   */
+  double makespan = 0;
+
+  /**
+   * @brief      utilization
+   *        * podil casu, kdy vlakna vykonavala ulohy:
+   *          soucet delek uloh / (workers * makespan)
+   *
+   * @return     vytizeni v intervalu [0, 1]
+   */
+  double utilization() const;
+
+  /**
+   * @brief      writeChromeTrace
+   *        * zapise rozvrh ve formatu Trace Event (JSON), kazde vlakno
+   *          grafu je jeden radek casove osy
+   */
+  void writeChromeTrace(std::ostream &out) const;
+
+  /**
+   * @brief      writeText
+   *        * zapise rozvrh jako text, jedna uloha na radek:
+   *          vlakno zacatek konec jmeno (casy v mikrosekundach)
+   */
+  void writeText(std::ostream &out) const;
+};
+
+/**
+ * @brief Graf uloh vykonavany fondem vlaken
+ * Graf se nejdrive sestavi (add, depend) a pak jednou spusti (run). Kazde
+ * vlakno grafu ma vlastni frontu pripravenych uloh: ulohy uvolnene
+ * dokoncenim sve predchudkyne bere z jejiho konce (pokracuje tedy po
+ * kriticke ceste bez predavani mezi vlakny), a pokud je fronta prazdna,
+ * krade nejstarsi ulohy ze zacatku front ostatnich vlaken.
+ *
+ * Telo ulohy nesmi cekat na ulohy stejneho fondu vlaken (parallelFor),
+ * jinak hrozi uvaznuti. Ulohy proto pouzivaji jadra v jednom vlakne,
+ * paralelismus zajistuje samotny graf.
+ */
+class TaskGraph
+{
+public:
+  typedef size_t TaskId;
+
+  /**
+   * @brief      add
+   *        * prida ulohu do grafu
+   *
+   * @param      name   jmeno ulohy v zaznamu prubehu
+   * @param      body   telo ulohy
+   *
+   * @return     identifikator ulohy
+   */
+  TaskId add(const std::string &name, std::function<void()> body);
+
+  /**
+   * @brief      depend
+   *        * uloha task se spusti az po dokonceni ulohy prerequisite
+   *
+   * @param      task          zavisla uloha
+   * @param      prerequisite  predchudkyne, musi byt pridana drive nez task
+   *                           (graf je tak vzdy acyklicky)
+   */
+  void depend(TaskId task, TaskId prerequisite);
+
+  /**
+   * @brief      pocet uloh grafu
+   */
+  size_t size() const { return mTasks.size(); }
+
+  /**
+   * @brief      run
+   *        * vykona vsechny ulohy v poradi danem zavislostmi, graf
+   *          zpracovava pool.size() vlaken vcetne volajiciho. Prvni
+   *          vyjimka vyhozena nekterou z uloh zastavi spousteni dalsich
+   *          a je po dokonceni rozbehnutych uloh znovu vyhozena.
+   *
+   * @param      pool   fond vlaken
+   * @param      trace  zaznam prubehu (nullptr = nezaznamenavat)
+   */
+  void run(ThreadPool &pool, TaskTrace *trace = nullptr);
+
+protected:
+  /**
+   * Uloha grafu
+   */
+  struct Task
+  {
+    std::string name;
+    std::function<void()> body;
+    std::vector<TaskId> successors;
+    size_t prerequisites;
+  };
+
+  std::vector<Task> mTasks;
+};
+
+#endif /* TASK_GRAPH_H_ */
+
+/*** Konec souboru task_graph.h ***/
@@ -0,0 +1,228 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - work-stealing thread pool
+//
+// $NoKeywords: $ivs_project_1 $thread_pool.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file thread_pool.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Definice metod fondu vlaken s kradenim prace.
+ */
+
+#include <exception>
+
+#include "thread_pool.h"
+
+/**
+ * Fond a index fronty, ke kterym patri aktualni pracovni vlakno
+ */
+static thread_local const ThreadPool *tCurrentPool = nullptr;
+static thread_local size_t tCurrentIndex = 0;
+
+static std::mutex sharedLock;
+static std::unique_ptr<ThreadPool> sharedPool;
+
+ThreadPool::ThreadPool(size_t threads): mPending(0), mNextQueue(0), mStop(false)
+{
+    if(threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if(threads == 0)
+        threads = 1;
+
+    for(size_t i = 0; i + 1 < threads; i++)
+        mWorkers.push_back(std::unique_ptr<Worker>(new Worker()));
+
+    for(size_t i = 0; i < mWorkers.size(); i++)
+        mThreads.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(mSleepLock);
+        mStop = true;
+    }
+    mWake.notify_all();
+
+    for(size_t i = 0; i < mThreads.size(); i++)
+        mThreads[i].join();
+}
+
+ThreadPool &ThreadPool::shared()
+{
+    std::lock_guard<std::mutex> guard(sharedLock);
+
+    if(!sharedPool)
+        sharedPool.reset(new ThreadPool(0));
+
+    return *sharedPool;
+}
+
+void ThreadPool::setSharedThreads(size_t threads)
+{
+    std::lock_guard<std::mutex> guard(sharedLock);
+
+    sharedPool.reset();
+    sharedPool.reset(new ThreadPool(threads));
+}
+
+size_t ThreadPool::currentIndex() const
+{
+    if(tCurrentPool == this)
+        return tCurrentIndex;
+
+    return mWorkers.size();
+}
+
+void ThreadPool::push(size_t index, std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> guard(mWorkers[index]->lock);
+        mWorkers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> guard(mSleepLock);
+        mPending++;
+    }
+    mWake.notify_one();
+}
+
+bool ThreadPool::tryTake(size_t self, std::function<void()> &task)
+{
+    if(self < mWorkers.size())
+    {
+        Worker &own = *mWorkers[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+
+        if(!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            mPending--;
+            return true;
+        }
+    }
+
+    for(size_t i = 1; i <= mWorkers.size(); i++)
+    {
+        size_t victim = (self + i) % (mWorkers.size() + 1);
+
+        if(victim == mWorkers.size())
+            continue;
+
+        Worker &other = *mWorkers[victim];
+        std::lock_guard<std::mutex> guard(other.lock);
+
+        if(!other.tasks.empty())
+        {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            mPending--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index)
+{
+    tCurrentPool = this;
+    tCurrentIndex = index;
+
+    for(;;)
+    {
+        std::function<void()> task;
+
+        if(tryTake(index, task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepLock);
+        mWake.wait(lock, [this] { return mStop || mPending > 0; });
+
+        if(mStop && mPending == 0)
+            return;
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)> &body)
+{
+    if(count == 0)
+        return;
+
+    if(count == 1 || mWorkers.empty())
+    {
+        for(size_t i = 0; i < count; i++)
+            body(i);
+        return;
+    }
+
+    /**
+     * Spolecny stav jedne skupiny uloh
+     */
+    struct Group
+    {
+        std::atomic<size_t> remaining;
+        std::mutex lock;
+        std::condition_variable done;
+        std::exception_ptr error;
+    } group;
+
+    group.remaining = count;
+
+    size_t self = currentIndex();
+
+    // Vlastni vlakno bere z konce sve fronty, ulohy se proto vkladaji
+    // v obracenem poradi, aby se vykonavaly zhruba v poradi indexu
+    for(size_t n = count; n-- > 0; )
+    {
+        size_t queue = self < mWorkers.size() ? self : mNextQueue++ % mWorkers.size();
+
+        push(queue, [&group, &body, n]() {
+            try
+            {
+                body(n);
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> guard(group.lock);
+                if(!group.error)
+                    group.error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> guard(group.lock);
+            if(--group.remaining == 0)
+                group.done.notify_all();
+        });
+    }
+
+    while(group.remaining > 0)
+    {
+        std::function<void()> task;
+
+        if(tryTake(self, task))
+        {
+            task();
+            continue;
+        }
+
+        // Zbyvajici ulohy skupiny uz nekdo vykonava
+        std::unique_lock<std::mutex> lock(group.lock);
+        group.done.wait(lock, [&group] { return group.remaining == 0; });
+    }
+
+    // Posledni uloha muze jeste drzet zamek skupiny, skupina nesmi zaniknout drive
+    std::lock_guard<std::mutex> guard(group.lock);
+
+    if(group.error)
+        std::rethrow_exception(group.error);
+}
+
+/*** Konec souboru thread_pool.cpp ***/
@@ -0,0 +1,151 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - work-stealing thread pool
+//
+// $NoKeywords: $ivs_project_1 $thread_pool.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file thread_pool.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Deklarace perzistentniho fondu vlaken s kradenim prace
+ *        (work-stealing), sdileneho maticovymi operacemi.
+ */
+
+#pragma once
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fond vlaken s kradenim prace
+ * Kazde pracovni vlakno ma vlastni frontu uloh, nove ulohy bere z jejiho
+ * konce a pokud je prazdna, krade ulohy ze zacatku front ostatnich vlaken.
+ * Vlakno cekajici na dokonceni skupiny uloh (parallelFor) mezitim samo
+ * vykonava cekajici ulohy, takze parallelFor lze bezpecne vnorovat.
+ */
+class ThreadPool
+{
+public:
+  /**
+   * @brief ThreadPool
+   * Konstruktor vytvori fond s celkovym poctem threads vlaken. Volajici
+   * vlakno se pocita mezi ne, spusti se tedy threads - 1 pracovnich vlaken.
+   *
+   * @param      threads  pocet vlaken (0 znamena pocet jader procesoru)
+   */
+  explicit ThreadPool(size_t threads);
+
+  /**
+   * @brief ~ThreadPool
+   * Destruktor, pocka na dokonceni uloh a ukonci pracovni vlakna.
+   */
+  ~ThreadPool();
+
+  /**
+   * @brief      size
+   *
+   * @return     celkovy pocet vlaken vcetne volajiciho
+   */
+  size_t size() const { return mWorkers.size() + 1; }
+
+  /**
+   * @brief      parallelFor
+   *        * spusti body(i) pro vsechna i z [0, count) a pocka na jejich
+   *          dokonceni. Prvni vyjimka vyhozena nekterou z uloh je po
+   *          dokonceni ostatnich znovu vyhozena.
+   *
+   * @param      count  pocet uloh
+   * @param      body   telo ulohy
+   */
+  void parallelFor(size_t count, const std::function<void(size_t)> &body);
+
+  /**
+   * @brief      shared
+   *        * vrati sdileny fond vlaken, pri prvnim pouziti jej vytvori
+   *
+   * @return     sdileny fond vlaken
+   */
+  static ThreadPool &shared();
+
+  /**
+   * @brief      setSharedThreads
+   *        * nastavi pocet vlaken sdileneho fondu (0 znamena pocet jader).
+   *          Nesmi byt volano, dokud sdileny fond vykonava nejake ulohy.
+   *
+   * @param      threads  pocet vlaken
+   */
+  static void setSharedThreads(size_t threads);
+
+protected:
+  ThreadPool(const ThreadPool &);
+  ThreadPool &operator=(const ThreadPool &);
+
+  /**
+   * Fronta uloh jednoho pracovniho vlakna
+   */
+  struct Worker
+  {
+    std::mutex lock;
+    std::deque<std::function<void()> > tasks;
+  };
+
+  std::vector<std::unique_ptr<Worker> > mWorkers;
+
+  std::vector<std::thread> mThreads;
+
+  /**
+   * Pocet uloh cekajicich ve frontach, chraneny mSleepLock pri zvysovani
+   */
+  std::atomic<size_t> mPending;
+
+  std::atomic<size_t> mNextQueue;
+
+  std::mutex mSleepLock;
+
+  std::condition_variable mWake;
+
+  bool mStop;
+
+  /**
+   * @brief      hlavni smycka pracovniho vlakna
+   */
+  void workerLoop(size_t index);
+
+  /**
+   * @brief      vlozi ulohu do fronty vlakna index
+   */
+  void push(size_t index, std::function<void()> task);
+
+  /**
+   * @brief      vyzvedne ulohu z vlastni fronty, pripadne ji ukradne
+   *             z fronty jineho vlakna
+   *
+   * @param      self  index vlastni fronty (size() pro cizi vlakno)
+   * @param      task  vyzvednuta uloha
+   *
+   * @return     true, pokud byla nejaka uloha vyzvednuta
+   */
+  bool tryTake(size_t self, std::function<void()> &task);
+
+  /**
+   * @brief      index fronty volajiciho vlakna v tomto fondu
+   */
+  size_t currentIndex() const;
+};
+
+#endif /* THREAD_POOL_H_ */
+
+/*** Konec souboru thread_pool.h ***/
@@ -0,0 +1,236 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - tiled LU and Cholesky on a task graph
+//
+// $NoKeywords: $ivs_project_1 $tiled_factorization.cpp
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file tiled_factorization.cpp
+ * @author Andrej Pavlovič
+ *
+ * @brief Sestaveni grafu uloh dlazdicovych rozkladu. Ulohy pouzivaji jen
+ *        jadra v jednom vlakne (gemm, potrfTile, getrfTile, ...), viz
+ *        omezeni v TaskGraph.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tiled_factorization.h"
+#include "matrix_kernels.h"
+#include "task_graph.h"
+#include "thread_pool.h"
+
+namespace TiledFactorization
+{
+  using namespace MatrixKernels;
+
+  /**
+   * Oznaceni dlazdice, do ktere zatim zadna uloha nezapsala
+   */
+  static const TaskGraph::TaskId NO_TASK = static_cast<TaskGraph::TaskId>(-1);
+
+  /**
+   * Jmeno ulohy v zaznamu prubehu, napr. GEMM(0,2,1)
+   */
+  static std::string taskName(const char *kernel, size_t k, size_t i = NO_TASK, size_t j = NO_TASK)
+  {
+    std::string name = std::string(kernel) + "(" + std::to_string(k);
+
+    if(i != NO_TASK)
+      name += "," + std::to_string(i);
+    if(j != NO_TASK)
+      name += "," + std::to_string(j);
+
+    return name + ")";
+  }
+
+  /**
+   * Zavislost na uloze, pokud nejaka existuje
+   */
+  static void dependOn(TaskGraph &graph, TaskGraph::TaskId task, TaskGraph::TaskId prerequisite)
+  {
+    if(prerequisite != NO_TASK)
+      graph.depend(task, prerequisite);
+  }
+
+  bool potrf(MatrixView a, const Options &options)
+  {
+    if(a.rows() != a.cols())
+      throw std::runtime_error("Matice musi byt ctvercova.");
+
+    const size_t n = a.rows(), lda = a.stride();
+    const size_t nb = std::max<size_t>(options.tile, 1);
+    const size_t tiles = (n + nb - 1) / nb;
+    double *A = a.data();
+
+    auto size = [=](size_t t) { return std::min(nb, n - t * nb); };
+    auto tile = [=](size_t i, size_t j) { return A + i * nb * lda + j * nb; };
+
+    std::atomic<bool> failed(false);
+    TaskGraph graph;
+
+    // Posledni uloha, ktera zapsala dlazdici (i, j) dolniho trojuhelniku.
+    // Dokoncene dlazdice L se uz neprepisuji, staci tedy zavislosti na
+    // posledni zapis (cteni po zapisu i zapis po zapisu).
+    std::vector<TaskGraph::TaskId> last(tiles * tiles, NO_TASK);
+
+    for(size_t k = 0; k < tiles; k++)
+    {
+      // L_kk = chol(A_kk)
+      TaskGraph::TaskId t = graph.add(taskName("POTRF", k), [=, &failed]() {
+        if(!failed && !potrfTile(size(k), tile(k, k), lda))
+          failed = true;
+      });
+      dependOn(graph, t, last[k * tiles + k]);
+      last[k * tiles + k] = t;
+
+      // L_ik = A_ik L_kk^-T
+      for(size_t i = k + 1; i < tiles; i++)
+      {
+        t = graph.add(taskName("TRSM", k, i), [=, &failed]() {
+          if(!failed)
+            trsmRightLowerTransposed(size(i), size(k), tile(k, k), lda, tile(i, k), lda);
+        });
+        dependOn(graph, t, last[i * tiles + k]);
+        dependOn(graph, t, last[k * tiles + k]);
+        last[i * tiles + k] = t;
+      }
+
+      // Sloupec k + 1 se aktualizuje prvni, jeho POTRF tak muze zacit
+      // pred dokoncenim zbytku kroku k
+      for(size_t j = k + 1; j < tiles; j++)
+      {
+        // A_jj -= L_jk L_jk^T (SYRK, pocita se cela dlazdice)
+        t = graph.add(taskName("SYRK", k, j), [=, &failed]() {
+          if(!failed)
+            gemm(NO_TRANS, TRANS, size(j), size(j), size(k), -1.0, tile(j, k), lda,
+                 tile(j, k), lda, 1.0, tile(j, j), lda);
+        });
+        dependOn(graph, t, last[j * tiles + j]);
+        dependOn(graph, t, last[j * tiles + k]);
+        last[j * tiles + j] = t;
+
+        // A_ij -= L_ik L_jk^T
+        for(size_t i = j + 1; i < tiles; i++)
+        {
+          t = graph.add(taskName("GEMM", k, i, j), [=, &failed]() {
+            if(!failed)
+              gemm(NO_TRANS, TRANS, size(i), size(j), size(k), -1.0, tile(i, k), lda,
+                   tile(j, k), lda, 1.0, tile(i, j), lda);
+          });
+          dependOn(graph, t, last[i * tiles + j]);
+          dependOn(graph, t, last[i * tiles + k]);
+          dependOn(graph, t, last[j * tiles + k]);
+          last[i * tiles + j] = t;
+        }
+      }
+    }
+
+    graph.run(options.pool != nullptr ? *options.pool : ThreadPool::shared(), options.trace);
+
+    return !failed;
+  }
+
+  bool getrf(MatrixView a, size_t *pivots, double tolerance, const Options &options)
+  {
+    if(a.rows() != a.cols())
+      throw std::runtime_error("Matice musi byt ctvercova.");
+
+    const size_t n = a.rows(), lda = a.stride();
+    const size_t nb = std::max<size_t>(options.tile, 1);
+    const size_t tiles = (n + nb - 1) / nb;
+    double *A = a.data();
+
+    auto size = [=](size_t t) { return std::min(nb, n - t * nb); };
+    auto tile = [=](size_t i, size_t j) { return A + i * nb * lda + j * nb; };
+
+    std::atomic<bool> failed(false);
+    TaskGraph graph;
+
+    // Ulohy, ktere naposledy zapsaly do sloupce dlazdic j. Prohozeni radku
+    // zasahuje cely sloupec pod diagonalou, zavislosti se proto sleduji po
+    // sloupcich (dalsi krok sloupce ceka na vsechny GEMM predchoziho).
+    std::vector<std::vector<TaskGraph::TaskId> > writers(tiles);
+    TaskGraph::TaskId panel = NO_TASK;
+
+    for(size_t k = 0; k < tiles; k++)
+    {
+      // Rozklad panelu: radky [k nb, n) sloupcu dlazdice k
+      panel = graph.add(taskName("GETRF", k), [=, &failed]() {
+        size_t offset = k * nb;
+
+        if(failed || !getrfTile(n - offset, size(k), tile(k, k), lda, pivots + offset, tolerance))
+        {
+          failed = true;
+          return;
+        }
+
+        for(size_t p = offset; p < offset + size(k); p++)
+          pivots[p] += offset;
+      });
+
+      for(size_t w = 0; w < writers[k].size(); w++)
+        graph.depend(panel, writers[k][w]);
+
+      std::vector<TaskGraph::TaskId> updates;
+
+      for(size_t j = k + 1; j < tiles; j++)
+      {
+        // Prohozeni radku panelu ve sloupci j a U_kj = L_kk^-1 A_kj
+        TaskGraph::TaskId trsm = graph.add(taskName("TRSM", k, j), [=, &failed]() {
+          if(failed)
+            return;
+
+          laswp(size(j), tile(0, j), lda, k * nb, k * nb + size(k), pivots);
+          trsmLowerUnit(size(k), size(j), tile(k, k), lda, tile(k, j), lda);
+        });
+
+        graph.depend(trsm, panel);
+        for(size_t w = 0; w < writers[j].size(); w++)
+          graph.depend(trsm, writers[j][w]);
+
+        // A_ij -= L_ik U_kj
+        updates.clear();
+
+        for(size_t i = k + 1; i < tiles; i++)
+        {
+          TaskGraph::TaskId t = graph.add(taskName("GEMM", k, i, j), [=, &failed]() {
+            if(!failed)
+              gemm(size(i), size(j), size(k), -1.0, tile(i, k), lda, tile(k, j), lda,
+                   1.0, tile(i, j), lda);
+          });
+
+          graph.depend(t, trsm);
+          updates.push_back(t);
+        }
+
+        writers[j] = updates;
+      }
+    }
+
+    // Prohozeni radku pozdejsich panelu ve sloupcich L vlevo od nich. Kazda
+    // uloha, ktera cte L sloupce c, predchazi (pres sve nasledniky) poslednimu
+    // panelu, staci proto zavislost na nem.
+    for(size_t c = 0; c + 1 < tiles; c++)
+    {
+      TaskGraph::TaskId t = graph.add(taskName("LASWP", c), [=, &failed]() {
+        if(!failed)
+          laswp(size(c), tile(0, c), lda, (c + 1) * nb, n, pivots);
+      });
+
+      graph.depend(t, panel);
+    }
+
+    graph.run(options.pool != nullptr ? *options.pool : ThreadPool::shared(), options.trace);
+
+    return !failed;
+  }
+}
+
+/*** Konec souboru tiled_factorization.cpp ***/
@@ -0,0 +1,102 @@
+//======== Copyright (c) 2021, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     White Box - tiled LU and Cholesky on a task graph
+//
+// $NoKeywords: $ivs_project_1 $tiled_factorization.h
+// $Author:     Andrej Pavlovič <xpavlo14@stud.fit.vutbr.cz>
+// $Date:       $2026-10-16
+//============================================================================//
+/**
+ * @file tiled_factorization.h
+ * @author Andrej Pavlovič
+ *
+ * @brief Dlazdicovy LU a Choleskeho rozklad (ve stylu knihovny PLASMA).
+ *        Matice se rozdeli na dlazdice, kazda operace nad dlazdici
+ *        (POTRF, TRSM, SYRK, GEMM, u LU rozklad panelu) je uloha grafu
+ *        TaskGraph, ktera se spusti hned po dokonceni uloh, na jejichz
+ *        vysledku zavisi. Rozklad panelu kroku k + 1 tak bezi soubezne se
+ *        zbytkem aktualizaci kroku k, misto cekani na bariere po kazdem
+ *        kroku jako u MatrixKernels::getrf a potrf.
+ */
+
+#pragma once
+
+#ifndef TILED_FACTORIZATION_H_
+#define TILED_FACTORIZATION_H_
+
+#include <cstddef>
+
+#include "white_box_code.h"
+
+class ThreadPool;
+struct TaskTrace;
+
+namespace TiledFactorization
+{
+  /**
+   * Vychozi rozmer dlazdice, soucin dvou dlazdic je nekolik bloku gemm
+   * (GEMM_MC) a ulohy jsou dost velke, aby rezie planovani nebyla znat
+   */
+  const size_t DEFAULT_TILE = 192;
+
+  /**
+   * @brief Nastaveni rozkladu
+   */
+  struct Options
+  {
+    /**
+     * Rozmer ctvercovych dlazdic (okrajove mohou byt mensi)
+     */
+    size_t tile = DEFAULT_TILE;
+
+    /**
+     * Fond vlaken vykonavajici graf uloh (nullptr = ThreadPool::shared())
+     */
+    ThreadPool *pool = nullptr;
+
+    /**
+     * Zaznam rozvrhu uloh (nullptr = nezaznamenavat)
+     */
+    TaskTrace *trace = nullptr;
+  };
+
+  /**
+   * @brief      potrf
+   *        * Choleskeho rozklad A = L L^T na miste, vysledek odpovida
+   *          MatrixKernels::potrf (cte se jen dolni trojuhelnik, po
+   *          rozkladu v nem lezi L, horni trojuhelnik diagonalnich dlazdic
+   *          je nedefinovany). Pro nectvercovou matici vyhodi
+   *          std::runtime_error.
+   *
+   * @param      a        rozkladana matice
+   * @param      options  nastaveni
+   *
+   * @return     true, pokud je matice pozitivne definitni
+   */
+  bool potrf(MatrixView a, const Options &options = Options());
+
+  /**
+   * @brief      getrf
+   *        * LU rozklad s castecnou pivotaci PA = LU na miste, stejny
+   *          vystup jako MatrixKernels::getrf (lze jej pouzit napr.
+   *          v getrs). Panel (sloupce jedne dlazdice pod diagonalou) se
+   *          rozklada cely jednou ulohou, prohozeni radku a TRSM pro
+   *          kazdy dalsi sloupec dlazdic jsou samostatne ulohy, GEMM pro
+   *          kazdou dlazdici zbytku take. Prohozeni radku vlevo od panelu
+   *          se provede na konci. Pro nectvercovou matici vyhodi
+   *          std::runtime_error.
+   *
+   * @param      a          rozkladana matice
+   * @param      pivots     pole a.rows() indexu (viz MatrixKernels::getrf)
+   * @param      tolerance  pivot s absolutni hodnotou <= tolerance se
+   *                        povazuje za nulovy
+   * @param      options    nastaveni
+   *
+   * @return     true, pokud je matice regularni
+   */
+  bool getrf(MatrixView a, size_t *pivots, double tolerance, const Options &options = Options());
+}
+
+#endif /* TILED_FACTORIZATION_H_ */
+
+/*** Konec souboru tiled_factorization.h ***/
@@ -15,344 +15,525 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <cstring>
 
 #include "white_box_code.h"
+#include "factorization.h"
 
-Matrix::Matrix(): mRows(1), mCols(1)
+
+Matrix::BasicMatrix()
 {
-    matrix = std::vector<std::vector< double > >(1, std::vector<double>(1, 0));
+    allocate(1, 1);
 }
 
-Matrix::Matrix(size_t row, size_t col): mRows(row), mCols(col)
+Matrix::BasicMatrix(size_t row, size_t col)
 {
     if(row < 1 || col < 1)
         throw std::runtime_error("Minimalni velikost matice je 1x1");
     
-    matrix = std::vector<std::vector< double > >(row, std::vector<double>(col, 0));
+    allocate(row, col);
 }
 
-Matrix::~Matrix()
+Matrix::BasicMatrix(size_t row, size_t col, NoInit)
 {
+    if(row < 1 || col < 1)
+        throw std::runtime_error("Minimalni velikost matice je 1x1");
 
+    allocate(row, col, false);
 }
 
-bool Matrix::set(size_t row, size_t col, double value)
+bool Matrix::set(const std::vector<std::vector< double > > &values)
 {
-    if(!checkIndexes(row, col))
+    if(values.size() != mRows)
         return false;
+
+    for(size_t r = 0; r < mRows; r++)
+    {
+        if(values[r].size() != mCols)
+            return false;
+    }
     
-    matrix[row][col] = value;
+    for(size_t r = 0; r < mRows; r++)
+    {
+        memcpy(mData + r * mStride, values[r].data(), mCols * sizeof(double));
+    }
     
     return true;
 }
 
-bool Matrix::set(std::vector<std::vector< double > > values)
+bool Matrix::operator==(const Matrix &m) const
 {
-    bool fit = true;
-
-    if(matrix.size() != values.size())
+    if(!checkEqualSize(m))
+        throw std::runtime_error("Matice musi mit stejnou velikost.");
+    
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+    
+    for(size_t r = 0; r < mRows; r++)
     {
-        fit = false;
+        if(!kernels.equal(mCols, &at(r, 0), &m.at(r, 0)))
+            return false;
     }
+    
+    return true;
+}
 
-    for(int r = 0; r < matrix.size(); r++)
+Matrix Matrix::operator+(const Matrix &m) const &
+{
+    if(!checkEqualSize(m))
+        throw std::runtime_error("Matice musi mit stejnou velikost.");
+    
+    Matrix result(mRows, mCols, NO_INIT);
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+    
+    for(size_t r = 0; r < mRows; r++)
     {
-        if(values[r].size() != matrix[r].size())
-        {
-            fit = false;
-        }
+        kernels.add(mCols, &at(r, 0), &m.at(r, 0), &result.at(r, 0));
     }
+    
+    return result;
+}
 
-    if(!fit)
-    {
-        return fit;
-    }
+Matrix Matrix::operator+(const Matrix &m) &&
+{
+    if(!checkEqualSize(m))
+        throw std::runtime_error("Matice musi mit stejnou velikost.");
     
-    for(int r = 0; r < matrix.size(); r++)
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+    
+    for(size_t r = 0; r < mRows; r++)
     {
-        for(int c = 0; c < matrix[0].size(); c++)
-        {
-            matrix[r][c] = values[r][c];
-        }
+        kernels.add(mCols, &at(r, 0), &m.at(r, 0), &at(r, 0));
     }
     
-    return true;
+    return std::move(*this);
 }
 
-double Matrix::get(size_t row, size_t col)
+Matrix Matrix::operator+(Matrix &&m) const &
 {
-    if(!checkIndexes(row, col))
-        throw std::runtime_error("Pristup k indexu mimo matici");
+    return std::move(m) + *this;
+}
 
-    return matrix[row][col];
+Matrix Matrix::operator+(Matrix &&m) &&
+{
+    return std::move(*this) + static_cast<const Matrix &>(m);
 }
 
-bool Matrix::operator==(const Matrix m) const
+/**
+ * Soucin op(a) * op(b), transponovane operandy se ctou primo z puvodnich dat
+ */
+static Matrix multiply(MatrixKernels::Op opA, const Matrix &a, MatrixKernels::Op opB, const Matrix &b)
 {
-    if(!checkEqualSize(m))
-        throw std::runtime_error("Matice musi mit stejnou velikost.");
+    size_t m = opA == MatrixKernels::NO_TRANS ? a.rows() : a.cols();
+    size_t k = opA == MatrixKernels::NO_TRANS ? a.cols() : a.rows();
+    size_t kb = opB == MatrixKernels::NO_TRANS ? b.rows() : b.cols();
+    size_t n = opB == MatrixKernels::NO_TRANS ? b.cols() : b.rows();
+
+    if(k != kb)
+        throw std::runtime_error("Prvni matice musi stejny pocet sloupcu jako druha radku.");
+
+    Matrix result(m, n, Matrix::NO_INIT);
+
+    MatrixKernels::gemmParallel(nullptr, opA, opB, m, n, k, 1.0, a.data(), a.stride(),
+                                b.data(), b.stride(), 0.0, result.data(), result.stride());
+
+    return result;
+}
+
+Matrix Matrix::operator*(const Matrix &m) const
+{
+    return multiply(MatrixKernels::NO_TRANS, *this, MatrixKernels::NO_TRANS, m);
+}
+
+Matrix Matrix::operator*(const double value) const &
+{
+    Matrix result(mRows, mCols, NO_INIT);
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+  
+    for(size_t r = 0; r < mRows; r++)
+    {
+        kernels.scale(mCols, value, &at(r, 0), &result.at(r, 0));
+    }
     
-    for(int r = 0; r < matrix.size(); r++)
+    return result;
+}
+
+Matrix Matrix::operator*(const double value) &&
+{
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+  
+    for(size_t r = 0; r < mRows; r++)
     {
-        for (int c = 0; c < matrix[r].size(); c++)
-        {
-            if(matrix[r][c] != m.matrix[r][c])
-                return false;
-        }
+        kernels.scale(mCols, value, &at(r, 0), &at(r, 0));
     }
     
-    return true;
+    return std::move(*this);
 }
 
-Matrix Matrix::operator+(const Matrix m) const
+Matrix &Matrix::operator+=(const ConstMatrixView &m)
 {
-    if(!checkEqualSize(m))
+    if(mRows != m.rows() || mCols != m.cols())
         throw std::runtime_error("Matice musi mit stejnou velikost.");
     
-    Matrix result = Matrix(matrix.size(), matrix[0].size());
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
     
-    for(int r = 0; r < matrix.size(); r++)
+    for(size_t r = 0; r < mRows; r++)
     {
-        for(int c = 0; c < matrix[r].size(); c++)
-        {
-            result.set(r, c, matrix[r][c] + m.matrix[r][c]);
-        }
+        kernels.add(mCols, &at(r, 0), m.data() + r * m.stride(), &at(r, 0));
     }
     
-    return result;
+    return *this;
 }
 
+Matrix &Matrix::operator-=(const ConstMatrixView &m)
+{
+    return axpy(-1.0, m);
+}
 
-Matrix Matrix::operator*(const Matrix m) const
+Matrix &Matrix::operator*=(const double value)
 {
-    if(matrix[0].size() == m.matrix.size())
-    {
-        Matrix result = Matrix(matrix.size(), m.matrix[0].size());
-        
-        for(int r = 0; r < matrix.size(); r++)
-        {
-            for(int c = 0; c < m.matrix[0].size(); c++)
-            {
-                for(int i = 0; i < matrix[r].size(); i++)
-                {
-                    result.set(r, c, result.get(r, c) +  matrix[r][i] * m.matrix[i][c]);
-                }
-            }
-        }
-        
-        return result;
-    }
-    else
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+  
+    for(size_t r = 0; r < mRows; r++)
     {
-        throw std::runtime_error("Prvni matice musi stejny pocet sloupcu jako druha radku.");
+        kernels.scale(mCols, value, &at(r, 0), &at(r, 0));
     }
+    
+    return *this;
 }
 
-Matrix Matrix::operator*(const double value) const
+Matrix &Matrix::axpy(double alpha, const ConstMatrixView &x)
 {
-    Matrix result = Matrix(matrix.size(), matrix[0].size());
-  
-    for(int r = 0; r < matrix.size(); r++)
+    if(mRows != x.rows() || mCols != x.cols())
+        throw std::runtime_error("Matice musi mit stejnou velikost.");
+    
+    const MatrixKernels::ElementwiseKernels &kernels = MatrixKernels::elementwise();
+    
+    for(size_t r = 0; r < mRows; r++)
     {
-        for(int c = 0; c < matrix[r].size(); c++)
-        {
-            result.set(r, c, matrix[r][c] * value);
-        }
+        kernels.fma(mCols, alpha, x.data() + r * x.stride(), &at(r, 0), &at(r, 0));
     }
     
-    return result;
+    return *this;
+}
+
+std::vector<double> Matrix::operator*(const std::vector<double> &x) const
+{
+    if(x.size() != mCols)
+        throw std::runtime_error("Prvni matice musi stejny pocet sloupcu jako druha radku.");
+
+    std::vector<double> y(mRows);
+
+    MatrixKernels::gemv(nullptr, MatrixKernels::NO_TRANS, mRows, mCols, 1.0, mData, mStride,
+                        x.data(), 0.0, y.data());
+
+    return y;
+}
+
+std::vector<double> Matrix::solveEquation(const std::vector<double> &b)
+{
+    return solveEquation(std::vector<double>(b));
 }
 
-std::vector<double> Matrix::solveEquation(std::vector<double> b)
+std::vector<double> Matrix::solveEquation(std::vector<double> &&b)
 {
-    std::vector<double> res = std::vector<double>(matrix.size(), 0);
+    if(mCols != b.size())
+        throw std::runtime_error("Pocet prvku prave strany rovnice musi odpovidat poctu radku matice.");
     
-    std::vector<std::vector<double> > temp = 
-        std::vector<std::vector< double > >(matrix.size(), std::vector<double>(matrix.size(), 0));
-        
-    if(matrix[0].size() != b.size())
+    return Factorization(*this).solve(std::move(b));
+}
+
+std::vector<double> Matrix::solveEquation(const std::vector<double> &b, SolveMethod method)
+{
+    if(method == SOLVE_QR)
+        return leastSquares(b);
+    
+    if(mCols != b.size())
         throw std::runtime_error("Pocet prvku prave strany rovnice musi odpovidat poctu radku matice.");
     
-    if(!checkSquare())
+    if(method == SOLVE_MIXED && checkSquare())
+    {
+        std::vector<double> x(b);
+
+        if(MatrixKernels::gesvMixed(mRows, mData, mStride, x.data()) > 0)
+            return x;
+    }
+
+    return Factorization(*this, method).solve(b);
+}
+
+std::vector<double> Matrix::leastSquares(const std::vector<double> &b) const
+{
+    if(mRows != b.size())
+        throw std::runtime_error("Pocet prvku prave strany rovnice musi odpovidat poctu radku matice.");
+    
+    if(mRows < mCols)
+        throw std::runtime_error("Matice musi mit alespon tolik radku jako sloupcu.");
+    
+    Matrix qr(*this);
+    std::vector<double> x(b);
+    
+    if(!MatrixKernels::gels(nullptr, mRows, mCols, qr.mData, qr.mStride, x.data(), singularTolerance()))
+        throw std::runtime_error("Matice nema plnou hodnost.");
+    
+    x.resize(mCols);
+    
+    return x;
+}
+
+Matrix Matrix::cholesky() const
+{
+    if(mRows != mCols)
         throw std::runtime_error("Matice musi byt ctvercova.");
-  
-    double determinatAll = determinant();
-  
-    if(abs(determinatAll) < std::numeric_limits<double>::epsilon())
-        throw std::runtime_error("Matice je singularni.");
     
-    for(int i = 0; i < matrix.size(); i++)
+    Matrix l(*this);
+    
+    if(!MatrixKernels::potrf(mRows, l.mData, l.mStride))
+        throw std::runtime_error("Matice neni pozitivne definitni.");
+    
+    for(size_t r = 0; r < mRows; r++)
     {
-        for(int j = 0; j < matrix[i].size(); j++)
-        {
-            temp[i][j] = matrix[i][j];
-        }
+        for(size_t c = r + 1; c < mCols; c++)
+            l.at(r, c) = 0;
     }
     
-    for(int i = 0; i < matrix.size(); i++)
+    return l;
+}
+
+double Matrix::singularTolerance() const
+{
+    double maxAbs = 0;
+    
+    for(size_t r = 0; r < mRows; r++)
     {
-        for(int k = 0; k < matrix[i].size(); k++)
+        for(size_t c = 0; c < mCols; c++)
         {
-            temp[k][i] = b[k];
+            if(std::fabs(at(r, c)) > maxAbs)
+                maxAbs = std::fabs(at(r, c));
         }
-        
-        res[i] = deter(temp, temp.size())/determinatAll;
-        
-        for(int k = 0; k < matrix[i].size(); k++)
-            temp[k][i] = matrix[k][i];
     }
     
-    return res;
-}
-
-bool Matrix::checkIndexes(size_t row, size_t col)
-{
-    if(row >= matrix.size() || col >=  matrix[0].size())
-        return false;
-  
-    return true;
+    return maxAbs * mRows * std::numeric_limits<double>::epsilon();
 }
 
 bool Matrix::checkSquare()
 {
-    if(matrix.size() == matrix[0].size())
+    if(mRows == mCols)
         return true;
     
     return false;
 }
 
-bool Matrix::checkEqualSize(const Matrix m) const
+bool Matrix::checkEqualSize(const Matrix &m) const
 {
-    if(m.matrix.size() == matrix.size() && m.matrix[0].size() ==  matrix[0].size())
-        return true;
-    
-    return false;
+    return checkEqualSize(m.mRows, m.mCols);
 }
 
 double Matrix::determinant()
 {
-    if(matrix.size() == 1)
+    return ::determinant(ConstMatrixView(*this));
+}
+
+double Matrix::logDeterminant(int &sign)
+{
+    if(!checkSquare())
+        throw std::runtime_error("Matice musi byt ctvercova.");
+    
+    Matrix lu(*this);
+    std::vector<size_t> pivots(mRows);
+    
+    if(!MatrixKernels::getrf(mRows, lu.mData, lu.mStride, pivots.data(), 0.0))
     {
-        return matrix[0][0];
+        sign = 0;
+        return -std::numeric_limits<double>::infinity();
     }
-    else if(matrix.size() == 2)
+    
+    double logDet = 0;
+    sign = 1;
+    
+    for(size_t k = 0; k < mRows; k++)
     {
-        return matrix[0][0]*matrix[1][1] - matrix[1][0]*matrix[0][1];
+        double pivot = lu.at(k, k);
+        
+        if(pivots[k] != k)
+            sign = -sign;
+        if(pivot < 0)
+            sign = -sign;
+        
+        logDet += std::log(std::fabs(pivot));
     }
-    else if(matrix.size() == 3)
-    {
-        return matrix[0][0]*matrix[1][1]*matrix[2][2] +
-            matrix[0][1]*matrix[1][2]*matrix[2][0] + 
-            matrix[0][2]*matrix[1][0]*matrix[2][1] - 
-            matrix[2][0]*matrix[1][1]*matrix[0][2] - 
-            matrix[2][1]*matrix[1][2]*matrix[0][0] - 
-            matrix[2][2]*matrix[0][1]*matrix[1][0];
     
+    return logDet;
+}
+
+MatrixTranspose Matrix::transpose() const &
+{
+    return MatrixTranspose(*this);
+}
+
+Matrix Matrix::transpose() &&
+{
+    transposeInPlace();
+
+    return std::move(*this);
+}
+
+Matrix::BasicMatrix(const MatrixTranspose &t)
+{
+    const Matrix &m = t.base();
+
+    allocate(m.mCols, m.mRows, false);
+    MatrixKernels::transpose(m.mRows, m.mCols, m.mData, m.mStride, mData, mStride);
+}
+
+void Matrix::transposeInPlace()
+{
+    if(mRows == mCols)
+    {
+        MatrixKernels::transposeInPlace(mRows, mData, mStride);
     }
     else
     {
-        return deter(matrix, matrix.size());
+        *this = Matrix(transpose());
     }
 }
 
+Matrix Matrix::operator*(const MatrixTranspose &m) const
+{
+    return multiply(MatrixKernels::NO_TRANS, *this, MatrixKernels::TRANS, m.base());
+}
 
-std::vector< std::vector<double> > getMinimo( std::vector< std::vector<double> > src, int I, int J, int ordSrc )
+Matrix::BasicMatrix(const ConstMatrixView &view)
 {
-    std::vector< std::vector<double> > minimo( ordSrc-1, std::vector<double> (ordSrc-1,0));
+    allocate(view.rows(), view.cols(), false);
 
-    int rowCont = 0;
-    
-    for(int i=0; i < ordSrc; i++)
+    for(size_t r = 0; r < mRows; r++)
     {
-        int colCont = 0;
-        
-        if(i != I)
-        {
-            for(int j=0; j < ordSrc; j++)
-            {
-                if(j != J)
-                {
-                    minimo[rowCont][colCont] = src[i][j];
-                    colCont++; 
-                }
-            }
-            
-            rowCont++;
-        }
+        memcpy(mData + r * mStride, view.data() + r * view.stride(), mCols * sizeof(double));
     }
-    
-    return minimo;
 }
 
-double Matrix::deter(std::vector<std::vector<double> > m, size_t n)
+Matrix::BasicMatrix(const MatrixF &other)
 {
-    if(n == 1)
-        return m[0][0];
+    allocate(other.rows(), other.cols(), false);
 
-    if(n == 2)
+    for(size_t r = 0; r < mRows; r++)
     {
-        double mainDiag = m[0][0] * m[1][1];
-        double negDiag = m[1][0] * m[0][1];
-
-        return mainDiag - negDiag; 
+        for(size_t c = 0; c < mCols; c++)
+            at(r, c) = other.data()[r * other.stride() + c];
     }
-    else
-    {
-        double det = 0;
-        for(int J = 0; J < n; J++)
-        {
-            std::vector< std::vector<double> > min = getMinimo( m, 0, J, n);
-            if((J % 2) == 0)
-            {
-                det += m[0][J] * deter( min, n-1);
-            }
-            else
-            {
-                det -= m[0][J] * deter( min, n-1);
-            }
-        }
-        
-        return det;
-    }
-    
-    return 0;
 }
 
-Matrix Matrix::transpose()
+MatrixView Matrix::block(size_t row, size_t col, size_t rows, size_t cols)
 {
-    Matrix transposedMatrix(mCols, mRows);
-    for(int r = 0; r < mRows; r++)
-    {
-        for(int c = 0; c < mCols; c++)
-        {
-            transposedMatrix.set(c,r, matrix[r][c]);
-        }
-    }
+    return MatrixView(*this).block(row, col, rows, cols);
+}
 
-    return transposedMatrix;
+ConstMatrixView Matrix::block(size_t row, size_t col, size_t rows, size_t cols) const
+{
+    return ConstMatrixView(*this).block(row, col, rows, cols);
+}
+
+MatrixView Matrix::row(size_t row)
+{
+    return block(row, 0, 1, mCols);
+}
+
+ConstMatrixView Matrix::row(size_t row) const
+{
+    return block(row, 0, 1, mCols);
+}
+
+MatrixView Matrix::col(size_t col)
+{
+    return block(0, col, mRows, 1);
+}
+
+ConstMatrixView Matrix::col(size_t col) const
+{
+    return block(0, col, mRows, 1);
+}
+
+double MatrixTranspose::get(size_t row, size_t col) const
+{
+    if(row >= rows() || col >= cols())
+        throw std::runtime_error("Pristup k indexu mimo matici");
+
+    return mMatrix.at(col, row);
+}
+
+Matrix MatrixTranspose::operator*(const Matrix &m) const
+{
+    return multiply(MatrixKernels::TRANS, mMatrix, MatrixKernels::NO_TRANS, m);
+}
+
+Matrix MatrixTranspose::operator*(const MatrixTranspose &m) const
+{
+    return multiply(MatrixKernels::TRANS, mMatrix, MatrixKernels::TRANS, m.mMatrix);
+}
+
+std::vector<double> MatrixTranspose::operator*(const std::vector<double> &x) const
+{
+    if(x.size() != cols())
+        throw std::runtime_error("Prvni matice musi stejny pocet sloupcu jako druha radku.");
+
+    std::vector<double> y(rows());
+
+    MatrixKernels::gemv(nullptr, MatrixKernels::TRANS, mMatrix.mRows, mMatrix.mCols, 1.0,
+                        mMatrix.mData, mMatrix.mStride, x.data(), 0.0, y.data());
+
+    return y;
+}
+
+std::vector<double> MatrixTranspose::solveEquation(const std::vector<double> &b) const
+{
+    if(rows() != b.size())
+        throw std::runtime_error("Pocet prvku prave strany rovnice musi odpovidat poctu radku matice.");
+
+    if(mMatrix.mRows != mMatrix.mCols)
+        throw std::runtime_error("Matice musi byt ctvercova.");
+
+    Matrix lu(mMatrix);
+    std::vector<size_t> pivots(lu.mRows);
+    std::vector<double> x(b);
+
+    if(!MatrixKernels::getrf(lu.mRows, lu.mData, lu.mStride, pivots.data(), mMatrix.singularTolerance()))
+        throw std::runtime_error("Matice je singularni.");
+
+    MatrixKernels::getrsTransposed(lu.mRows, lu.mData, lu.mStride, pivots.data(), x.data());
+
+    return x;
 }
 
 Matrix Matrix::inverse()
 {
-    Matrix inversedMatrix(mRows, mCols);
+    if(!checkSquare())
+    {
+        throw std::runtime_error("Matice musi byt ctvercova.");
+    }
 
-    if(!(mRows == 2 && mCols == 2) && !(mRows == 3 && mCols == 3))
+    if(mRows != 2 && mRows != 3)
     {
-        throw std::runtime_error("Matice musi byt velikosti 2x2 nebo 3x3.");
+        return inverseLU();
     }
 
+    Matrix inversedMatrix(mRows, mCols);
+
+    // Stejny relativni prah jako pivot v inverseLU: |det| <= n eps max|a_ij|^n
     double deter = determinant();
-    if( abs(deter) < std::numeric_limits<double>::epsilon() )
+    double tolerance = singularTolerance();
+    double maxAbs = tolerance / (mRows * std::numeric_limits<double>::epsilon());
+
+    if( std::fabs(deter) <= tolerance * std::pow(maxAbs, mRows - 1.0) )
     {
         throw std::runtime_error("Matice je singularni.");
     }
 
     if(mRows == 2 && mCols == 2)
     {
-        inversedMatrix.set(0, 0, matrix[1][1] / deter);
-        inversedMatrix.set(1, 0, -1.0 * matrix[1][0] / deter);
-        inversedMatrix.set(0, 1, -1.0 * matrix[0][1] / deter);
-        inversedMatrix.set(1, 1, matrix[0][0] / deter);
+        inversedMatrix.set(0, 0, at(1, 1) / deter);
+        inversedMatrix.set(1, 0, -1.0 * at(1, 0) / deter);
+        inversedMatrix.set(0, 1, -1.0 * at(0, 1) / deter);
+        inversedMatrix.set(1, 1, at(0, 0) / deter);
     }
     else
     {
@@ -360,7 +541,7 @@ Matrix Matrix::inverse()
         {
             for(int c = 0; c < mCols; c++)
             {
-                inversedMatrix.set(c, r, (matrix[(r+1)%3][(c+1)%3]*matrix[(r+2)%3][(c+2)%3] - matrix[(r+2)%3][(c+1)%3]*matrix[(r+1)%3][(c+2)%3]) / deter);
+                inversedMatrix.set(c, r, (at((r+1)%3, (c+1)%3)*at((r+2)%3, (c+2)%3) - at((r+2)%3, (c+1)%3)*at((r+1)%3, (c+2)%3)) / deter);
             }
         }
     }
@@ -368,4 +549,27 @@ Matrix Matrix::inverse()
     return inversedMatrix;
 }
 
+Matrix Matrix::inverseLU()
+{
+    Matrix lu(*this);
+    std::vector<size_t> pivots(mRows);
+
+    if(!MatrixKernels::getrf(mRows, lu.mData, lu.mStride, pivots.data(), singularTolerance()))
+    {
+        throw std::runtime_error("Matice je singularni.");
+    }
+
+    Matrix inversedMatrix(mRows, mCols);
+
+    for(size_t i = 0; i < mRows; i++)
+    {
+        inversedMatrix.at(i, i) = 1.0;
+    }
+
+    MatrixKernels::getrsBatch(nullptr, mRows, mCols, lu.mData, lu.mStride, pivots.data(),
+                              inversedMatrix.mData, inversedMatrix.mStride);
+
+    return inversedMatrix;
+}
+
 /*** Konec souboru white_box_code.cpp ***/
\ No newline at end of file
@@ -26,19 +26,60 @@
 #include <vector>
 #include <limits>
 #include <cmath>
+#include <cstddef>
+
+#include "matrix_kernels.h"
+#include "matrix_storage.h"
+
+template<class E> class MatrixExpr;
+class MatrixTranspose;
+template<class T> class BasicMatrix;
+typedef BasicMatrix<double> Matrix;
+typedef BasicMatrix<float> MatrixF;
+template<class T> class BasicMatrixView;
+typedef BasicMatrixView<double> MatrixView;
+typedef BasicMatrixView<const double> ConstMatrixView;
+typedef BasicMatrixView<float> MatrixViewF;
+typedef BasicMatrixView<const float> ConstMatrixViewF;
+
+/**
+ * Metoda reseni soustavy linearnich rovnic (viz Matrix::solveEquation
+ * a Factorization)
+ */
+enum SolveMethod
+{
+  SOLVE_LU,         ///< LU rozklad s castecnou pivotaci, libovolna regularni matice
+  SOLVE_CHOLESKY,   ///< Choleskeho rozklad, symetricka pozitivne definitni matice
+  SOLVE_AUTO,       ///< Cholesky pro symetrickou matici, pri neuspechu LU
+  SOLVE_QR,         ///< Householderuv QR rozklad, i pro matice s vice radky nez sloupci
+  SOLVE_MIXED       ///< LU rozklad ve float, zpresneni v double (v Factorization jako SOLVE_LU)
+};
+
+/**
+ * Algoritmus nasobeni matic (viz multiply v matrix_view.h)
+ */
+enum MultiplyPolicy
+{
+  MULTIPLY_CLASSIC,     ///< blokovy GEMM, chyba omezena po prvcich
+  MULTIPLY_STRASSEN     ///< Strassen-Winograd od MatrixKernels::STRASSEN_THRESHOLD
+};
 
 /**
  * @brief Trida reprezuntiji matici
- * 
+ * Matice je sablona nad typem prvku, Matrix je matice typu double
+ * s uplnou sadou operaci. Obecna sablona (basic_matrix.h) slouzi pro
+ * matice v jednoduche presnosti (MatrixF). Uloziste, pristup k prvkum,
+ * kopirovani a presun obe dedi z MatrixStorage.
  */
-class Matrix
+template<>
+class BasicMatrix<double> : public MatrixStorage<double>
 {
 public:
   /**
    * @brief Matrix
    * Kontruktor vytvori nulovou matici velikosti 1x1
    */
-  Matrix();
+  BasicMatrix();
   /**
    * @brief Matrix
    * Kontruktor vytvori nulovou matici velikosti row x col
@@ -46,24 +87,84 @@ public:
    * @param      row    radek matice
    * @param      col    sloupec matice
    */
-  Matrix(size_t row, size_t col);
+  BasicMatrix(size_t row, size_t col);
+
+  /**
+   * Znacka konstruktoru, ktery prvky nenuluje
+   */
+  enum NoInit { NO_INIT };
 
   /**
    * @brief Matrix
-   * Destruktor
+   * Kontruktor vytvori matici row x col s nedefinovanymi prvky, pro
+   * vysledek operace, jejiz jadro zapise vsechny prvky (nuluje se jen
+   * vypln za poslednim sloupcem). Stejne jako Matrix(row, col) vyhodi
+   * std::runtime_error pro row < 1 nebo col < 1.
    */
-  ~Matrix();
+  BasicMatrix(size_t row, size_t col, NoInit);
+
   /**
-   * @brief      set
-   *      * nastavi hodnotu v matici na pozici x,y
+   * @brief Matrix
+   * Kopirovaci konstruktor, vytvori hlubokou kopii matice
    *
-   * @param      row    radek matice
-   * @param      col    sloupec matice
-   * @param      value  hodnota ulozena na pozici x,y
+   * @param      other  kopirovana matice
+   */
+  BasicMatrix(const Matrix &other) = default;
+
+  /**
+   * @brief Matrix
+   * Presunovaci konstruktor, prevezme uloziste matice other bez kopirovani.
+   * Matice other zustane prazdna (0x0) a lze ji pouze znovu priradit nebo
+   * zrusit.
    *
-   * @return     pokud bylo vlozeni uspesne vrati true, jinak false
+   * @param      other  presouvana matice
+   */
+  BasicMatrix(Matrix &&other) = default;
+
+  /**
+   * @brief Matrix
+   * Konstruktor vytvori matici vyhodnocenim odlozeneho vyrazu (viz
+   * matrix_expr.h) v jedinem pruchodu
+   *
+   * @param      expr   vyhodnocovany vyraz
+   */
+  template<class E>
+  BasicMatrix(const MatrixExpr<E> &expr);
+
+  /**
+   * @brief      prirazeni
+   *        * zkopiruje obsah matice other do teto matice
+   *
+   * @param      other  kopirovana matice
+   *
+   * @return     reference na tuto matici
    */
-  bool set(size_t row, size_t col, double value);
+  Matrix &operator=(const Matrix &other) = default;
+
+  /**
+   * @brief      presunuti
+   *        * prevezme uloziste matice other, puvodni uloziste uvolni
+   *
+   * @param      other  presouvana matice
+   *
+   * @return     reference na tuto matici
+   */
+  Matrix &operator=(Matrix &&other) = default;
+
+  /**
+   * @brief      prirazeni vyrazu
+   *        * vyhodnoti odlozeny vyraz primo do teto matice, pri shodne
+   *          velikosti bez jakekoliv alokace
+   *
+   * @param      expr   vyhodnocovany vyraz
+   *
+   * @return     reference na tuto matici
+   */
+  template<class E>
+  Matrix &operator=(const MatrixExpr<E> &expr);
+
+  using MatrixStorage<double>::set;
+
   /**
    * @brief      set
    *      * nastavi matici hodnotami z pole
@@ -72,16 +173,7 @@ public:
    *
    * @return     pokud bylo vlozeni uspesne vrati true, jinak false
    */
-  bool set(std::vector<std::vector< double > > values);
-  /**
-   * @brief      get
-   *      * vrati hodnotu v matici na pozici x,y 
-   * @param      row    radek matice
-   * @param      col    sloupec matice
-   *
-   * @return     hodnota v matici na pozici x,y
-   */
-  double get(size_t row, size_t col);
+  bool set(const std::vector<std::vector< double > > &values);
 
     /**
    * @brief      porovnani
@@ -91,7 +183,7 @@ public:
    *
    * @return     pokud jsou matice shodne tak vrati true, jinak false
    */
-  bool operator==(const Matrix) const;
+  bool operator==(const Matrix &) const;
 
   /**
    * @brief      scitani
@@ -101,7 +193,16 @@ public:
    *
    * @return     vysledna matice po secteni matic
    */
-  Matrix operator+(const Matrix) const;
+  Matrix operator+(const Matrix &) const &;
+
+  /**
+   * @brief      scitani s docasnou matici
+   *        * varianty pro docasne (rvalue) operandy zapisi soucet do
+   *          uloziste docasne matice a vrati ji, nic nealokuji
+   */
+  Matrix operator+(const Matrix &) &&;
+  Matrix operator+(Matrix &&) const &;
+  Matrix operator+(Matrix &&) &&;
 
   /**
    * @brief      nasobeni
@@ -111,7 +212,7 @@ public:
    *
    * @return     vysledna matice po vynasobeni matic
    */
-  Matrix operator*(const Matrix) const;
+  Matrix operator*(const Matrix &) const;
 
   /**
    * @brief      skalarni nasobeni
@@ -121,57 +222,240 @@ public:
    *
    * @return     vysledna matice po vynasobeni matice skalarem
    */
-  Matrix operator*(const double value) const;
+  Matrix operator*(const double value) const &;
+
+  /**
+   * @brief      skalarni nasobeni docasne matice
+   *        * vynasobi docasnou matici na miste a vrati ji, nic nealokuje
+   */
+  Matrix operator*(const double value) &&;
+
+  /**
+   * @brief      pricteni na miste
+   *        * this = this + m, zapisuje do uloziste teto matice a nic
+   *          nealokuje. m muze byt i tato matice, nesmi se ale s ni
+   *          castecne prekryvat (napr. posunuty pohled do ni).
+   *
+   * @param      m     pricitana matice (pohled) stejne velikosti
+   *
+   * @return     tato matice
+   */
+  Matrix &operator+=(const ConstMatrixView &m);
+
+  /**
+   * @brief      odecteni na miste
+   *        * this = this - m, bez alokace
+   */
+  Matrix &operator-=(const ConstMatrixView &m);
+
+  /**
+   * @brief      skalarni nasobeni na miste
+   *        * this = value * this, bez alokace
+   */
+  Matrix &operator*=(const double value);
+
+  /**
+   * @brief      axpy
+   *        * this = alpha * x + this jednim pruchodem (FMA), bez alokace
+   *          a bez docasne matice alpha * x
+   *
+   * @param      alpha   skalarni cinitel
+   * @param      x       pricitana matice (pohled) stejne velikosti
+   *
+   * @return     tato matice
+   */
+  Matrix &axpy(double alpha, const ConstMatrixView &x);
+
+  /**
+   * @brief      nasobeni vektorem
+   *        * y = A x jadrem MatrixKernels::gemv, vektor se neprevadi na
+   *          matici n x 1
+   *
+   * @param      x     vektor delky cols()
+   *
+   * @return     vektor delky rows()
+   */
+  std::vector<double> operator*(const std::vector<double> &x) const;
 
   /**
    * @brief      reseni spoustavy linearnich rovnic
-   *        * soustava rovnic je resena pomoci cramerova pravidla
+   *        * soustava rovnic je resena pomoci LU rozkladu s castecnou
+   *          pivotaci a nasledne dopredne a zpetne substituce, O(n^3).
+   *          Pro vice pravych stran se stejnou matici viz Factorization.
    *
    * @param      b prava strana rovnice
    *
    * @return     pole vysledku x1, x2, ...
    */
-  std::vector<double> solveEquation(std::vector<double> b);
+  std::vector<double> solveEquation(const std::vector<double> &b);
+
+  /**
+   * @brief      reseni spoustavy linearnich rovnic
+   *        * docasna prava strana je prepsana resenim a vracena
+   */
+  std::vector<double> solveEquation(std::vector<double> &&b);
+
+  /**
+   * @brief      reseni spoustavy linearnich rovnic zvolenou metodou
+   *        * SOLVE_CHOLESKY potrebuje polovinu operaci LU a cte jen dolni
+   *          trojuhelnik matice, SOLVE_AUTO jej zkusi pro symetrickou
+   *          matici a pokud neni pozitivne definitni, pouzije LU.
+   *          SOLVE_QR resi ulohu nejmensich ctvercu (viz leastSquares).
+   *          SOLVE_MIXED rozlozi matici ve float (polovicni objem dat,
+   *          dvojnasobna sirka SIMD) a reseni zpresni v double, pro
+   *          spatne podminenou matici pouzije LU v double
+   *          (viz MatrixKernels::gesvMixed)
+   *
+   * @param      b       prava strana rovnice
+   * @param      method  metoda reseni
+   *
+   * @return     pole vysledku x1, x2, ...
+   */
+  std::vector<double> solveEquation(const std::vector<double> &b, SolveMethod method);
+
+  /**
+   * @brief      reseni ulohy nejmensich ctvercu min ||A x - b||
+   *        * pro matici s alespon tolika radky jako sloupci pomoci
+   *          blokoveho Householderova QR rozkladu, normalni rovnice se
+   *          nesestavuji. Vysoke matice se rozkladaji po pruzich radku
+   *          paralelne (TSQR).
+   *
+   * @param      b prava strana rovnice delky rows()
+   *
+   * @return     pole vysledku x1, x2, ... delky cols()
+   */
+  std::vector<double> leastSquares(const std::vector<double> &b) const;
+
+  /**
+   * @brief      Choleskeho rozklad A = L L^T
+   *        * pro matici, ktera neni pozitivne definitni, vyhodi
+   *          std::runtime_error
+   *
+   * @return     dolni trojuhelnikova matice L
+   */
+  Matrix cholesky() const;
 
   /**
    * @brief      vypocet transponovane matice A^T
-   *        * prehozeni indexu
+   *        * vrati odlozeny pohled, ktery nic nekopiruje. Soucin a reseni
+   *          soustavy s pohledem ctou puvodni matici primo, pri prirazeni
+   *          do matice se transpozice provede blokove (cache-oblivious).
+   *          Pohled odkazuje na tuto matici a nesmi ji prezit.
    *
    * @return     transponovana matici
    */
-  Matrix transpose();
+  MatrixTranspose transpose() const &;
 
   /**
-   * @brief      vypocet invertovane matice A^-1
+   * @brief      transpozice docasne matice
+   *        * pohled na docasnou matici by po skonceni vyrazu odkazoval na
+   *          zaniklou matici, docasna matice se proto transponuje na miste
+   *          (viz transposeInPlace) a vrati se primo vysledek
    *
-   * @return     invertovana matici
+   * @return     transponovana matice
    */
-  Matrix inverse();
+  Matrix transpose() &&;
 
+  /**
+   * @brief      transpozice na miste
+   *        * ctvercova matice se transponuje bez alokace, ostatni se
+   *          transponuji do noveho uloziste
+   */
+  void transposeInPlace();
 
+  /**
+   * @brief Matrix
+   * Konstruktor vytvori matici z transponovaneho pohledu
+   *
+   * @param      t      transponovany pohled
+   */
+  BasicMatrix(const MatrixTranspose &t);
 
+  /**
+   * @brief      nasobeni transponovanou matici
+   *        * vynasobi matici A^T bez vytvoreni kopie A
+   *
+   * @param      m - druhy cinitel
+   *
+   * @return     vysledna matice po vynasobeni matic
+   */
+  Matrix operator*(const MatrixTranspose &m) const;
 
+  /**
+   * @brief Matrix
+   * Konstruktor vytvori (souvislou) kopii casti matice dane pohledem
+   *
+   * @param      view   kopirovany pohled
+   */
+  explicit BasicMatrix(const ConstMatrixView &view);
+
+  /**
+   * @brief Matrix
+   * Konstruktor vytvori matici z matice v jednoduche presnosti (presne,
+   * kazdy float je reprezentovatelny v double)
+   *
+   * @param      other  prevadena matice
+   */
+  explicit BasicMatrix(const MatrixF &other);
 
-protected:
   /**
-   * 2D pole reprezentujici matici
+   * @brief      block
+   *        * pohled na blok rows x cols zacinajici na pozici row, col,
+   *          nic nekopiruje (viz matrix_view.h). Zapis do pohledu meni
+   *          tuto matici.
+   *
+   * @return     pohled sdilejici data s touto matici
+   */
+  MatrixView block(size_t row, size_t col, size_t rows, size_t cols);
+  ConstMatrixView block(size_t row, size_t col, size_t rows, size_t cols) const;
+
+  /**
+   * @brief      pohled na jeden radek matice
    */
-  std::vector<std::vector<double> > matrix;
+  MatrixView row(size_t row);
+  ConstMatrixView row(size_t row) const;
 
-  size_t mRows;
-  
-  size_t mCols;
+  /**
+   * @brief      pohled na jeden sloupec matice
+   */
+  MatrixView col(size_t col);
+  ConstMatrixView col(size_t col) const;
+
+  /**
+   * @brief      vypocet invertovane matice A^-1
+   *        * matice 2x2 a 3x3 primo pomoci adjungovane matice, ostatni
+   *          pomoci blokoveho LU rozkladu a reseni A X = I, O(n^3).
+   *          Singularita se u vsech radu posuzuje relativne k max|a_ij|
+   *          (viz singularTolerance), pro singularni matici vyhodi
+   *          std::runtime_error.
+   *
+   * @return     invertovana matici
+   */
+  Matrix inverse();
+
+  /**
+   * @brief      vypocte dereminant matice
+   *        * matice radu 1 az 3 primo z definice, vyssi rady pomoci LU
+   *          rozkladu s castecnou pivotaci v O(n^3)
+   *
+   * @return     Vrati hodnotu determinantu matice
+   */
+  double determinant();
 
   /**
-   * @brief      kontrola zda indexy row, col jsou v matici
+   * @brief      vypocte logaritmus absolutni hodnoty determinantu
+   *        * pro velke matice, jejichz determinant by pretekl nebo
+   *          podtekl rozsah typu double
    *
-   * @param      row   radek matice
-   * @param      col   sloupec matice
+   * @param      sign  znamenko determinantu (-1, 0 nebo 1)
    *
-   * @return     Pokud je alespon jeden index mimo matici vrati false,
-   *             jinak true
+   * @return     ln|det A|, pro singularni matici -infinity
    */
-  bool checkIndexes(size_t row, size_t col);
+  double logDeterminant(int &sign);
+
+protected:
+  using MatrixStorage<double>::checkEqualSize;
+
   /**
    * @brief      kontrola zda maji matice shodnou velikost
    *
@@ -179,7 +463,7 @@ protected:
    *
    * @return     Pokud maji matice shodnou velikost vrati true, jinak false
    */
-  bool checkEqualSize(const Matrix m) const;
+  bool checkEqualSize(const Matrix &m) const;
 
   /**
    * @brief      kontrola zda je matice ctvercova
@@ -187,24 +471,88 @@ protected:
    * @return     pokud je matice ctvercova tak vrati true, jinak false
    */
   bool checkSquare();
+
   /**
-   * @brief      vypocte dereminant matice
+   * @brief      prah pro rozpoznani nuloveho pivotu pri rozkladu
    *
-   * @return     Vrati hodnotu determinantu matice
+   * @return     n * epsilon * max|a_ij|
    */
-  double determinant();
+  double singularTolerance() const;
 
   /**
-   * @brief      Pomocna funkce pro vypocet determinantu matice vyssich radu
+   * @brief      obecna inverze matice libovolneho radu pomoci LU rozkladu
    *
-   * param       m matice 
-   * param       n rad matice 
-   * @return     Vrati hodnotu determinantu matice
+   * @return     invertovana matice
+   */
+  Matrix inverseLU();
+
+  /**
+   * @brief      vyhodnoti vyraz do uloziste teto matice stejne velikosti
    */
-  double deter(std::vector<std::vector<double> > m, size_t n);
+  template<class E>
+  void assignExpr(const E &expr);
+
+  friend class MatrixTranspose;
 };
 
+/**
+ * @brief Odlozeny transponovany pohled na matici
+ * Pohled pouze odkazuje na puvodni matici, operace s nim ctou jeji data
+ * primo v transponovanem poradi.
+ */
+class MatrixTranspose
+{
+public:
+  explicit MatrixTranspose(const Matrix &m): mMatrix(m) {}
+
+  size_t rows() const { return mMatrix.cols(); }
+
+  size_t cols() const { return mMatrix.rows(); }
+
+  /**
+   * @brief      puvodni (netransponovana) matice
+   */
+  const Matrix &base() const { return mMatrix; }
+
+  /**
+   * @brief      get
+   *      * vrati hodnotu na pozici row, col transponovane matice
+   */
+  double get(size_t row, size_t col) const;
+
+  /**
+   * @brief      nasobeni A^T * B bez kopie A
+   */
+  Matrix operator*(const Matrix &m) const;
+
+  /**
+   * @brief      nasobeni A^T * B^T bez kopie A i B
+   */
+  Matrix operator*(const MatrixTranspose &m) const;
+
+  /**
+   * @brief      nasobeni vektorem A^T x bez kopie A
+   */
+  std::vector<double> operator*(const std::vector<double> &x) const;
+
+  /**
+   * @brief      reseni soustavy A^T x = b
+   *        * pouzije LU rozklad puvodni matice A, transponovana matice se
+   *          nevytvari
+   *
+   * @param      b prava strana rovnice
+   *
+   * @return     pole vysledku x1, x2, ...
+   */
+  std::vector<double> solveEquation(const std::vector<double> &b) const;
+
+protected:
+  const Matrix &mMatrix;
+};
 
+#include "matrix_expr.h"
+#include "matrix_view.h"
+#include "basic_matrix.h"
 
 #endif /* MATRIX_H_ */
 
@@ -15,6 +15,23 @@
 
 #include "gtest/gtest.h"
 #include "white_box_code.h"
+#include "fixed_matrix.h"
+#include "thread_pool.h"
+#include "sparse_matrix.h"
+#include "iterative_solvers.h"
+#include "factorization.h"
+#include "matrix_batch.h"
+#include "matrix_file.h"
+#include "out_of_core.h"
+#include "task_graph.h"
+#include "tiled_factorization.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
 
 using namespace std;
 
@@ -55,6 +72,9 @@ TEST(MatrixConstructor, Matrix_1x1) {
 TEST(MatrixConstructor, Matrix_NxM) {
     // Class Matrix should throw exception
     EXPECT_THROW(Matrix(0, 0), runtime_error);
+    EXPECT_THROW(Matrix(0, 5, Matrix::NO_INIT), runtime_error);
+    EXPECT_THROW(Matrix(5, 0, Matrix::NO_INIT), runtime_error);
+    EXPECT_EQ(Matrix(2, 3, Matrix::NO_INIT).cols(), 3u);
 
     // Class Vector should throw exception
     EXPECT_THROW(Matrix(-1, -1), length_error);
@@ -91,6 +111,171 @@ TEST(MatrixConstructor, Matrix_NxM) {
     });
 }
 
+// Test storage layout and copying
+TEST_F(MatrixPreset, storage) {
+    // Rows are padded to whole cache lines and start on aligned addresses
+    EXPECT_EQ(large.stride() % MATRIX_ALIGN_ELEMS, 0u);
+    EXPECT_GE(large.stride(), large.cols());
+    for (size_t r = 0; r < large.rows(); r++)
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(large.data() + r * large.stride()) % MATRIX_ALIGN_BYTES, 0u);
+
+    // Element [r][c] lives at r * stride + c
+    EXPECT_EQ(large.data()[3 * large.stride() + 5], 65);
+
+    // Copies are deep
+    Matrix copy(large);
+    Matrix assigned = Matrix();
+    assigned = large;
+    EXPECT_TRUE(copy.set(3, 5, -1));
+    EXPECT_TRUE(assigned.set(3, 5, -2));
+    EXPECT_EQ(large.get(3, 5), 65);
+    EXPECT_EQ(copy.get(3, 5), -1);
+    EXPECT_EQ(assigned.get(3, 5), -2);
+    EXPECT_EQ(assigned.rows(), 5u);
+    EXPECT_EQ(assigned.cols(), 6u);
+}
+
+// Test move semantics and allocations of operator chains
+TEST_F(MatrixPreset, moveAndAllocations) {
+    // Move leaves the source empty without copying
+    size_t before = MatrixKernels::alignedAllocCount();
+    Matrix moved(std::move(large));
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before);
+    EXPECT_EQ(moved.get(3, 5), 65);
+    EXPECT_EQ(large.rows(), 0u);
+    EXPECT_ANY_THROW(large.get(0, 0));
+
+    Matrix target = Matrix();
+    before = MatrixKernels::alignedAllocCount();
+    target = std::move(moved);
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before);
+    EXPECT_EQ(target.get(3, 5), 65);
+
+    // Moved-from matrix can be assigned again
+    large = target;
+    EXPECT_TRUE(large == target);
+
+    Matrix a = medium;
+    Matrix b = medium * 2.0;
+    Matrix c = medium * -1.0;
+
+    // Arguments are passed by reference
+    before = MatrixKernels::alignedAllocCount();
+    EXPECT_FALSE(a == b);
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before);
+
+    // Only the first operation of a chain allocates, temporaries are reused
+    before = MatrixKernels::alignedAllocCount();
+    Matrix sum = a + b + c + a;
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before + 1);
+    EXPECT_TRUE(sum == medium * 3.0);
+
+    before = MatrixKernels::alignedAllocCount();
+    Matrix scaled = (a + b) * 0.5 + (c + a);
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before + 2);
+    EXPECT_TRUE(scaled == medium * 1.5);
+
+    // Product allocates its result, the sum operand is not copied
+    // (the first product reserves the gemm packing workspace of the thread)
+    Matrix warmUp = a * c;
+    before = MatrixKernels::alignedAllocCount();
+    Matrix product = (a + b) * c;
+    size_t productAllocs = MatrixKernels::alignedAllocCount() - before;
+    before = MatrixKernels::alignedAllocCount();
+    Matrix reference = a * c;
+    EXPECT_EQ(productAllocs, MatrixKernels::alignedAllocCount() - before + 1);
+    EXPECT_TRUE(product == reference * 3.0);
+
+    // Solve with a temporary right-hand side
+    vector<double> x = medium.solveEquation(vector<double>{1, 2, 3});
+    vector<double> rhs{1, 2, 3};
+    EXPECT_EQ(medium.solveEquation(rhs), x);
+    EXPECT_EQ(rhs, (vector<double>{1, 2, 3}));
+}
+
+// Test lazy expression templates
+TEST_F(MatrixPreset, lazyExpressions) {
+    Matrix a = medium;
+    Matrix b = medium * -3.0;
+    Matrix c = medium * 0.5;
+
+    // Whole expression is evaluated into a single new matrix
+    size_t before = MatrixKernels::alignedAllocCount();
+    Matrix fused = lazy(a) * 2.0 + b + c;
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before + 1);
+    EXPECT_TRUE(fused == a * 2.0 + b + c);
+
+    // Assignment into a matrix of the same size does not allocate, operands may alias the target
+    before = MatrixKernels::alignedAllocCount();
+    fused = 0.5 * (lazy(fused) - c) + a - lazy(b) * 2.0;
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before);
+    Matrix expected = (a * 2.0 + b + c + c * -1.0) * 0.5 + a + b * -2.0;
+    EXPECT_TRUE(fused == expected);
+
+    // Assignment into a matrix of different size reallocates it
+    small = lazy(large) + large;
+    EXPECT_TRUE(small == large * 2.0);
+
+    EXPECT_THROW(lazy(medium) + large, runtime_error);
+    EXPECT_THROW(medium - lazy(large), runtime_error);
+}
+
+// Test compound operators and output-parameter kernels
+TEST_F(MatrixPreset, inPlaceOperations) {
+    Matrix a = medium;
+
+    // Compound operators work in the existing storage
+    size_t before = MatrixKernels::alignedAllocCount();
+    a += medium;
+    a *= 3.0;
+    a -= medium;
+    a.axpy(-2.0, medium.block(0, 0, 3, 3));
+    a += a;
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before);
+    EXPECT_TRUE(a == medium * 6.0);
+
+    EXPECT_THROW(a += large, runtime_error);
+    EXPECT_THROW(a -= large, runtime_error);
+    EXPECT_THROW(a.axpy(1.0, large), runtime_error);
+
+    Matrix b = large * 2.0;
+
+    // Results of operators keep zero padding although they are not zero-filled
+    Matrix sum = large + b;
+    Matrix scaled = large * 3.0;
+    Matrix copy(large.block(1, 1, 3, 4));
+    for (const Matrix *m : {&sum, &scaled, &copy})
+        for (size_t r = 0; r < m->rows(); r++)
+            for (size_t c = m->cols(); c < m->stride(); c++)
+                EXPECT_EQ(m->data()[r * m->stride() + c], 0);
+    EXPECT_TRUE(sum == scaled);
+
+    // Output kernels overwrite every element and never read the output
+    Matrix out(5, 5);
+    Matrix outScaled(5, 6);
+    Matrix lt(large.transpose());
+    Matrix product = large * lt;
+    before = MatrixKernels::alignedAllocCount();
+    for (int i = 0; i < 3; i++)
+    {
+        for (size_t r = 0; r < 5; r++)
+            for (size_t c = 0; c < 5; c++)
+                out.set(r, c, std::nan(""));
+        multiply(large, lt, out);
+        EXPECT_TRUE(out == product);
+    }
+    multiply(large, 3.0, outScaled);
+    add(large, b, b);
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before);
+    EXPECT_TRUE(outScaled == scaled);
+    EXPECT_TRUE(b == scaled);
+
+    EXPECT_THROW(multiply(large, large, out), runtime_error);
+    EXPECT_THROW(multiply(medium, medium, medium), runtime_error);
+    EXPECT_THROW(multiply(large, 1.0, out), runtime_error);
+    EXPECT_THROW(add(large, b, out), runtime_error);
+}
+
 // Test set() 1/2
 TEST_F(MatrixPreset, setOne) {
     EXPECT_EQ(small.get(0, 0), 0);
@@ -337,6 +522,269 @@ TEST_F(MatrixPreset, multiplyMatrix) {
     });
 }
 
+// Test blocked matrix multiplication against naive product
+TEST(MatrixKernels, gemmRaggedBlocks) {
+    // Sizes chosen to leave partial register tiles and cross the KC and MC block boundaries
+    const size_t m = 131, k = 300, n = 19;
+    Matrix a(m, k);
+    Matrix b(k, n);
+
+    for (size_t r = 0; r < m; r++)
+        for (size_t c = 0; c < k; c++)
+            a.set(r, c, (double) ((r * 7 + c * 3) % 11) - 5);
+    for (size_t r = 0; r < k; r++)
+        for (size_t c = 0; c < n; c++)
+            b.set(r, c, (double) ((r * 5 + c) % 7) - 3);
+
+    Matrix product = a * b;
+
+    ASSERT_EQ(product.rows(), m);
+    ASSERT_EQ(product.cols(), n);
+
+    // Integer valued inputs keep every partial sum exact
+    for (size_t r = 0; r < m; r++) {
+        for (size_t c = 0; c < n; c++) {
+            double expected = 0;
+            for (size_t i = 0; i < k; i++)
+                expected += a.get(r, i) * b.get(i, c);
+            EXPECT_EQ(product.get(r, c), expected);
+        }
+    }
+
+    // C = alpha * A * B + beta * C
+    Matrix acc = product;
+    MatrixKernels::gemm(m, n, k, 2.0, a.data(), a.stride(), b.data(), b.stride(), -1.0, acc.data(), acc.stride());
+    EXPECT_TRUE(acc == product);
+}
+
+// Test thread pool task execution
+TEST(ThreadPool, parallelFor) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+
+    // Every index is visited exactly once
+    vector<atomic<int> > visits(1000);
+    for (size_t i = 0; i < visits.size(); i++)
+        visits[i] = 0;
+    pool.parallelFor(visits.size(), [&](size_t i) { visits[i]++; });
+    for (size_t i = 0; i < visits.size(); i++)
+        EXPECT_EQ(visits[i], 1);
+
+    // Nested loops do not deadlock, waiting threads execute queued tasks
+    atomic<int> total(0);
+    pool.parallelFor(16, [&](size_t) {
+        pool.parallelFor(16, [&](size_t) { total++; });
+    });
+    EXPECT_EQ(total, 256);
+
+    // Exception from a task is propagated to the caller
+    EXPECT_THROW(pool.parallelFor(8, [](size_t i) {
+        if (i == 5)
+            throw runtime_error("task failed");
+    }), runtime_error);
+
+    // Single threaded pool runs inline
+    ThreadPool serial(1);
+    int sum = 0;
+    serial.parallelFor(10, [&](size_t i) { sum += (int) i; });
+    EXPECT_EQ(sum, 45);
+}
+
+// Test tiled parallel multiplication against the single threaded kernel
+TEST(MatrixKernels, gemmParallelTiles) {
+    const size_t m = 150, k = 70, n = 90;
+    Matrix a(m, k);
+    Matrix b(k, n);
+
+    for (size_t r = 0; r < m; r++)
+        for (size_t c = 0; c < k; c++)
+            a.set(r, c, (double) ((r * 3 + c * 7) % 13) - 6);
+    for (size_t r = 0; r < k; r++)
+        for (size_t c = 0; c < n; c++)
+            b.set(r, c, (double) ((r + c * 5) % 9) - 4);
+
+    ASSERT_GE(m * n * k, MatrixKernels::GEMM_PARALLEL_MIN);
+
+    Matrix serial(m, n);
+    Matrix parallel(m, n);
+    ThreadPool pool(4);
+
+    MatrixKernels::gemm(m, n, k, 1.0, a.data(), a.stride(), b.data(), b.stride(), 0.0, serial.data(), serial.stride());
+    MatrixKernels::gemmParallel(&pool, m, n, k, 1.0, a.data(), a.stride(), b.data(), b.stride(), 0.0, parallel.data(), parallel.stride());
+    EXPECT_TRUE(serial == parallel);
+
+    // Thread count of the shared pool used by operator* is configurable
+    ThreadPool::setSharedThreads(3);
+    EXPECT_EQ(ThreadPool::shared().size(), 3u);
+    EXPECT_TRUE((a * b) == serial);
+    ThreadPool::setSharedThreads(0);
+}
+
+// Test every available SIMD variant against the scalar reference
+TEST(MatrixKernels, elementwiseIsaVariants) {
+    const MatrixKernels::ElementwiseKernels *reference = MatrixKernels::elementwiseFor(MatrixKernels::ISA_SCALAR);
+    ASSERT_NE(reference, nullptr);
+    EXPECT_TRUE(MatrixKernels::isaSupported(MatrixKernels::elementwise().isa));
+
+    // Lengths cover empty input, vector bodies and every tail length
+    const size_t maxLen = 37;
+    vector<double> x(maxLen), y(maxLen);
+    for (size_t i = 0; i < maxLen; i++) {
+        x[i] = (double) (i % 17) - 8 + 0.25;
+        y[i] = (double) (i % 5) * -3 + 0.5;
+    }
+
+    for (int isa = MatrixKernels::ISA_SCALAR; isa < MatrixKernels::ISA_COUNT; isa++) {
+        const MatrixKernels::ElementwiseKernels *kernels = MatrixKernels::elementwiseFor((MatrixKernels::Isa) isa);
+        if (kernels == nullptr)
+            continue;
+
+        SCOPED_TRACE(kernels->name);
+
+        for (size_t n = 0; n <= maxLen; n++) {
+            vector<double> expected(maxLen, 0), actual(maxLen, 0);
+
+            reference->add(n, x.data(), y.data(), expected.data());
+            kernels->add(n, x.data(), y.data(), actual.data());
+            EXPECT_EQ(expected, actual);
+
+            reference->scale(n, -0.5, x.data(), expected.data());
+            kernels->scale(n, -0.5, x.data(), actual.data());
+            EXPECT_EQ(expected, actual);
+
+            reference->fma(n, 0.5, x.data(), y.data(), expected.data());
+            kernels->fma(n, 0.5, x.data(), y.data(), actual.data());
+            EXPECT_EQ(expected, actual);
+
+            EXPECT_EQ(reference->dot(n, x.data(), y.data()), kernels->dot(n, x.data(), y.data()));
+
+            EXPECT_TRUE(kernels->equal(n, x.data(), x.data()));
+            if (n > 0) {
+                vector<double> z(x);
+                z[n - 1] += 1;
+                EXPECT_FALSE(kernels->equal(n, x.data(), z.data()));
+                EXPECT_EQ(reference->equal(n, x.data(), y.data()), kernels->equal(n, x.data(), y.data()));
+            }
+        }
+    }
+}
+
+// Float variants process twice as many elements per register, lengths cover every unrolled body
+TEST(MatrixKernels, elementwiseIsaVariantsFloat) {
+    const MatrixKernels::ElementwiseKernelsF *reference = MatrixKernels::elementwiseFor<float>(MatrixKernels::ISA_SCALAR);
+    ASSERT_NE(reference, nullptr);
+    EXPECT_EQ(MatrixKernels::elementwise<float>().isa, MatrixKernels::elementwise().isa);
+
+    const size_t maxLen = 70;
+    vector<float> x(maxLen), y(maxLen);
+    for (size_t i = 0; i < maxLen; i++) {
+        x[i] = (float) (i % 17) - 8 + 0.25f;
+        y[i] = (float) (i % 5) * -3 + 0.5f;
+    }
+
+    for (int isa = MatrixKernels::ISA_SCALAR; isa < MatrixKernels::ISA_COUNT; isa++) {
+        const MatrixKernels::ElementwiseKernelsF *kernels = MatrixKernels::elementwiseFor<float>((MatrixKernels::Isa) isa);
+        if (kernels == nullptr)
+            continue;
+
+        SCOPED_TRACE(kernels->name);
+
+        for (size_t n = 0; n <= maxLen; n++) {
+            vector<float> expected(maxLen, 0), actual(maxLen, 0);
+
+            reference->add(n, x.data(), y.data(), expected.data());
+            kernels->add(n, x.data(), y.data(), actual.data());
+            EXPECT_EQ(expected, actual);
+
+            reference->scale(n, -0.5f, x.data(), expected.data());
+            kernels->scale(n, -0.5f, x.data(), actual.data());
+            EXPECT_EQ(expected, actual);
+
+            reference->fma(n, 0.5f, x.data(), y.data(), expected.data());
+            kernels->fma(n, 0.5f, x.data(), y.data(), actual.data());
+            EXPECT_EQ(expected, actual);
+
+            EXPECT_EQ(reference->dot(n, x.data(), y.data()), kernels->dot(n, x.data(), y.data()));
+
+            EXPECT_TRUE(kernels->equal(n, x.data(), x.data()));
+            if (n > 0) {
+                vector<float> z(x);
+                z[n - 1] += 1;
+                EXPECT_FALSE(kernels->equal(n, x.data(), z.data()));
+            }
+        }
+    }
+}
+
+// Test matrix-vector products (integer data, every summation order is exact)
+TEST(MatrixKernels, gemv) {
+    ThreadPool pool(4);
+
+    // Wide matrix splits columns of the transposed product, tall one splits rows
+    for (size_t shape = 0; shape < 3; shape++) {
+        const size_t m = shape == 0 ? 7 : shape == 1 ? 300 : 5000;
+        const size_t n = shape == 0 ? 37 : shape == 1 ? 700 : 20;
+        SCOPED_TRACE(m);
+        Matrix a(m, n);
+        vector<double> x(n), xt(m);
+        for (size_t r = 0; r < m; r++)
+            for (size_t c = 0; c < n; c++)
+                a.set(r, c, (double) ((r * 3 + c * 7) % 13) - 6);
+        for (size_t c = 0; c < n; c++)
+            x[c] = (double) (c % 5) - 2;
+        for (size_t r = 0; r < m; r++)
+            xt[r] = (double) (r % 7) - 3;
+
+        vector<double> expected(m, 0), expectedT(n, 0);
+        for (size_t r = 0; r < m; r++)
+            for (size_t c = 0; c < n; c++) {
+                expected[r] += a.get(r, c) * x[c];
+                expectedT[c] += a.get(r, c) * xt[r];
+            }
+
+        EXPECT_EQ(a * x, expected);
+        EXPECT_EQ(a.transpose() * xt, expectedT);
+
+        // Parallel paths with alpha and beta, beta = 0 ignores NaN in y
+        vector<double> y(m, std::nan("")), yt(n, 1.0);
+        MatrixKernels::gemv(&pool, MatrixKernels::NO_TRANS, m, n, 2.0, a.data(), a.stride(), x.data(), 0.0, y.data());
+        MatrixKernels::gemv(&pool, MatrixKernels::TRANS, m, n, -1.0, a.data(), a.stride(), xt.data(), 3.0, yt.data());
+        for (size_t r = 0; r < m; r++)
+            EXPECT_EQ(y[r], 2.0 * expected[r]);
+        for (size_t c = 0; c < n; c++)
+            EXPECT_EQ(yt[c], 3.0 - expectedT[c]);
+    }
+
+    // Views pass their stride, output buffers are not allocated
+    Matrix a(6, 9);
+    for (size_t r = 0; r < 6; r++)
+        for (size_t c = 0; c < 9; c++)
+            a.set(r, c, (double) (r * 9 + c));
+    ConstMatrixView block = ConstMatrixView(a).block(1, 2, 4, 3);
+    vector<double> x{1, -1, 2}, xt{1, 0, 0, -1}, y(4), yt(3);
+    size_t before = MatrixKernels::alignedAllocCount();
+    multiply(block, x.data(), y.data());
+    multiplyTransposed(block, xt.data(), yt.data());
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before);
+    EXPECT_EQ(y, (vector<double>{25, 43, 61, 79}));
+    EXPECT_EQ(yt, (vector<double>{-27, -27, -27}));
+
+    EXPECT_THROW(a * vector<double>(6), runtime_error);
+    EXPECT_THROW(a.transpose() * vector<double>(9), runtime_error);
+
+    // Long dot products are split into blocks, integer data sums exactly
+    const size_t length = 3 * MatrixKernels::DOT_PARALLEL_MIN + 5;
+    vector<double> u(length), v(length);
+    double expected = 0;
+    for (size_t i = 0; i < length; i++) {
+        u[i] = (double) (i % 7) - 3;
+        v[i] = (double) (i % 5) - 2;
+        expected += u[i] * v[i];
+    }
+    EXPECT_EQ(MatrixKernels::dot(&pool, length, u.data(), v.data()), expected);
+    EXPECT_EQ(MatrixKernels::dot(&pool, 10, u.data(), v.data()), MatrixKernels::elementwise().dot(10, u.data(), v.data()));
+}
+
 // Test operator*() 2/2
 TEST_F(MatrixPreset, multiplyScalar) {
     // Matrices with multiplied values with multiply function
@@ -371,23 +819,1112 @@ TEST_F(MatrixPreset, multiplyScalar) {
 TEST_F(MatrixPreset, solveEquation) {
     medium.solveEquation(vector<double>{1, 2, 3});
 
-    //
+    // Result satisfies A * x = b
+    vector<double> x = medium.solveEquation(vector<double>{1, 2, 3});
+    ASSERT_EQ(x.size(), 3u);
+    for (size_t r = 0; r < 3; r++)
+        EXPECT_NEAR(medium.get(r, 0) * x[0] + medium.get(r, 1) * x[1] + medium.get(r, 2) * x[2], r + 1.0, 1e-12);
+
+    // 1x1 system
+    small.set(0, 0, 4);
+    EXPECT_EQ(small.solveEquation(vector<double>{2})[0], 0.5);
+
+    // System of size unusable with Cramer's rule, zero leading element forces pivoting
+    const size_t n = 12;
+    Matrix big(n, n);
+    vector<double> expected(n), b(n, 0);
+    for (size_t r = 0; r < n; r++) {
+        expected[r] = (double) r - 5.5;
+        for (size_t c = 0; c < n; c++)
+            big.set(r, c, r == c ? (r == 0 ? 0 : 20.0) : 1.0 / (1.0 + r + c));
+    }
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = 0; c < n; c++)
+            b[r] += big.get(r, c) * expected[c];
+    x = big.solveEquation(b);
+    for (size_t r = 0; r < n; r++)
+        EXPECT_NEAR(x[r], expected[r], 1e-10);
+
+    // Singular matrix, non square matrix and wrong right-hand side
+    Matrix singular(3, 3);
+    singular.set({
+        {1, 2, 3},
+        {2, 4, 6},
+        {0, 1, 1},
+    });
+    EXPECT_THROW(singular.solveEquation(vector<double>{1, 2, 3}), runtime_error);
+    EXPECT_THROW(Matrix(3, 3).solveEquation(vector<double>{1, 2, 3}), runtime_error);
+    EXPECT_THROW(large.solveEquation(vector<double>{1, 2, 3, 4, 5, 6}), runtime_error);
+    EXPECT_THROW(medium.solveEquation(vector<double>{1, 2}), runtime_error);
+}
+
+// Test determinant() and logDeterminant()
+TEST_F(MatrixPreset, determinant) {
+    EXPECT_EQ(small.determinant(), 0);
+    EXPECT_EQ(medium.determinant(), 4 * (-55 * 19 - 2 * 19) - 3 * (-9 * 19 - 2 * 18) - 8 * (-9 * 19 + 55 * 18));
+    EXPECT_THROW(large.determinant(), runtime_error);
+
+    // Pivoted LU path for order > 3 (row swap changes the sign)
+    Matrix m4(4, 4);
+    m4.set({
+        {0, 2, 0, 0},
+        {3, 0, 0, 0},
+        {0, 0, 4, 1},
+        {0, 0, 2, 1},
+    });
+    EXPECT_NEAR(m4.determinant(), -12, 1e-12);
+
+    int sign;
+    EXPECT_NEAR(m4.logDeterminant(sign), log(12.0), 1e-12);
+    EXPECT_EQ(sign, -1);
+
+    Matrix singular(5, 5);
+    EXPECT_EQ(singular.determinant(), 0);
+    EXPECT_EQ(singular.logDeterminant(sign), -numeric_limits<double>::infinity());
+    EXPECT_EQ(sign, 0);
+
+    // Determinant out of double range, log-determinant stays finite
+    const size_t n = 400;
+    Matrix big(n, n);
+    for (size_t i = 0; i < n; i++) {
+        big.set(i, i, i == 0 ? -10 : 10);
+        if (i + 1 < n)
+            big.set(i, i + 1, 1);
+    }
+    EXPECT_EQ(big.determinant(), -numeric_limits<double>::infinity());
+    EXPECT_NEAR(big.logDeterminant(sign), n * log(10.0), 1e-9);
+    EXPECT_EQ(sign, -1);
+}
+
+// Test compile-time sized matrices
+TEST_F(MatrixPreset, fixedMatrix) {
+    // Everything is evaluated at compile time
+    constexpr FixedMatrix<2, 2> a = {{1, 2, 3, 4}};
+    constexpr FixedMatrix<2, 3> b = {{1, 0, -1, 2, 1, 0}};
+    static_assert(a.determinant() == -2, "2x2 determinant");
+    static_assert(a.inverse() * a == FixedMatrix<2, 2>{{1, 0, 0, 1}}, "2x2 inverse");
+    static_assert(a * b == FixedMatrix<2, 3>{{5, 2, -1, 11, 4, -3}}, "2x3 product");
+    static_assert(b.transpose() == FixedMatrix<3, 2>{{1, 2, 0, 1, -1, 0}}, "transpose");
+    static_assert(FixedMatrix<1, 1>{{4}}.inverse() == FixedMatrix<1, 1>{{0.25}}, "1x1 inverse");
+    static_assert(FixedMatrix<4, 4>{{2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0, 0, 0, 0, 5}}.determinant() == 120, "4x4 determinant");
+
+    // Results agree with the dynamic matrix
+    FixedMatrix<3, 3> m3 = FixedMatrix<3, 3>::fromMatrix(medium);
+    EXPECT_EQ(m3(1, 1), -55);
+    EXPECT_EQ(m3.determinant(), medium.determinant());
+    Matrix inverse3 = static_cast<Matrix>(m3.inverse());
+    Matrix expected3 = medium.inverse();
+    for (size_t r = 0; r < 3; r++)
+        for (size_t c = 0; c < 3; c++)
+            EXPECT_NEAR(inverse3.get(r, c), expected3.get(r, c), 1e-15);
+    EXPECT_TRUE(static_cast<Matrix>(m3 * m3) == medium * medium);
+    EXPECT_TRUE(static_cast<Matrix>(m3.transpose()) == medium.transpose());
+
+    Matrix dynamic4(4, 4);
+    dynamic4.set({
+        {4, 1, 0, 2},
+        {1, -3, 2, 0},
+        {0, 2, 5, 1},
+        {2, 0, 1, 6},
+    });
+    FixedMatrix<4, 4> m4 = FixedMatrix<4, 4>::fromMatrix(dynamic4);
+    EXPECT_NEAR(m4.determinant(), dynamic4.determinant(), 1e-9);
+    FixedMatrix<4, 4> identity = m4 * m4.inverse();
+    for (size_t r = 0; r < 4; r++)
+        for (size_t c = 0; c < 4; c++)
+            EXPECT_NEAR(identity(r, c), r == c ? 1.0 : 0.0, 1e-14);
+
+    EXPECT_THROW((FixedMatrix<3, 3>::fromMatrix(large)), runtime_error);
+    EXPECT_THROW((FixedMatrix<2, 2>{{1, 2, 2, 4}}.inverse()), runtime_error);
 }
 
 // Test transpose()
 TEST_F(MatrixPreset, transpose) {
+    Matrix original = large;
+
     small = small.transpose();
     medium = medium.transpose();
     large = large.transpose();
 
-    //
+    EXPECT_EQ(small.get(0, 0), 0);
+    EXPECT_EQ(medium.get(0, 1), -9);
+    EXPECT_EQ(medium.get(1, 0), 3);
+    ASSERT_EQ(large.rows(), 6u);
+    ASSERT_EQ(large.cols(), 5u);
+    for (size_t r = 0; r < 5; r++)
+        for (size_t c = 0; c < 6; c++)
+            EXPECT_EQ(large.get(c, r), original.get(r, c));
+
+    // Blocked kernel on sizes crossing several recursion levels, in place for square matrices
+    const size_t sizes[][2] = {{37, 70}, {70, 37}, {64, 64}, {53, 53}};
+    for (size_t s = 0; s < 4; s++) {
+        const size_t m = sizes[s][0], n = sizes[s][1];
+        Matrix a(m, n);
+        for (size_t r = 0; r < m; r++)
+            for (size_t c = 0; c < n; c++)
+                a.set(r, c, r * 1000.0 + c);
+
+        Matrix t = a.transpose();
+        Matrix inPlace = a;
+        inPlace.transposeInPlace();
+        ASSERT_EQ(t.rows(), n);
+        ASSERT_EQ(inPlace.rows(), n);
+        for (size_t r = 0; r < m; r++) {
+            for (size_t c = 0; c < n; c++) {
+                EXPECT_EQ(t.get(c, r), a.get(r, c));
+                EXPECT_EQ(inPlace.get(c, r), a.get(r, c));
+                EXPECT_EQ(a.transpose().get(c, r), a.get(r, c));
+            }
+        }
+    }
+    EXPECT_THROW(original.transpose().get(5, 5), runtime_error);
+
+    // Products and solves read the transposed operand without copying it
+    Matrix warmUp = large * original;
+    size_t before = MatrixKernels::alignedAllocCount();
+    Matrix product = original.transpose() * original;
+    size_t lazyAllocs = MatrixKernels::alignedAllocCount() - before;
+    before = MatrixKernels::alignedAllocCount();
+    Matrix reference = large * original;
+    EXPECT_EQ(lazyAllocs, MatrixKernels::alignedAllocCount() - before);
+    EXPECT_TRUE(product == reference);
+    EXPECT_TRUE(original * original.transpose() == original * large);
+    EXPECT_TRUE(original.transpose() * large.transpose() == large * original);
+    EXPECT_THROW(original.transpose() * large, runtime_error);
+
+    // A temporary is transposed eagerly, no view can outlive it
+    static_assert(is_same<decltype((original * large).transpose()), Matrix>::value, "rvalue transpose");
+    auto fromTemporary = (original * large).transpose();
+    Matrix square = original * large;
+    EXPECT_TRUE(fromTemporary == Matrix(square.transpose()));
+    EXPECT_TRUE(Matrix(original).transpose() == large);
+
+    Matrix a = Matrix(3, 3);
+    a.set({
+        {0, 2, 1},
+        {3, -1, 4},
+        {1, 1, 7},
+    });
+    vector<double> x = a.transpose().solveEquation(vector<double>{1, 2, 3});
+    vector<double> expected = Matrix(a.transpose()).solveEquation(vector<double>{1, 2, 3});
+    for (size_t i = 0; i < 3; i++)
+        EXPECT_NEAR(x[i], expected[i], 1e-14);
+    EXPECT_THROW(original.transpose().solveEquation(vector<double>{1, 2, 3, 4, 5, 6}), runtime_error);
 }
 
 // Test inverse()
 TEST_F(MatrixPreset, inverse) {
     medium = medium.inverse();
 
-    //
+    // A * A^-1 = I for closed form and general paths
+    Matrix original(3, 3);
+    original.set({
+        {4   , 3,  -8},
+        {-9.0, -55, 2},
+        {18  , 19,  19},
+    });
+    const size_t sizes[] = {1, 2, 3, 4, 50, 130};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        const size_t n = sizes[s];
+        Matrix a(n, n);
+        for (size_t r = 0; r < n; r++)
+            for (size_t c = 0; c < n; c++)
+                a.set(r, c, r == c ? n + 1.0 : 1.0 / (1.0 + (r * 7 + c * 3) % 5) - (r == 0 && c == 0 ? n + 1.0 : 0.0));
+        if (n == 3)
+            a = original;
+
+        Matrix product = a * a.inverse();
+        for (size_t r = 0; r < n; r++)
+            for (size_t c = 0; c < n; c++)
+                EXPECT_NEAR(product.get(r, c), r == c ? 1.0 : 0.0, 1e-12) << n << "x" << n;
+    }
+
+    // Small-scaled but well-conditioned matrices invert at every order, singularity is relative
+    for (size_t n = 2; n <= 4; n++) {
+        Matrix scaled(n, n);
+        for (size_t i = 0; i < n; i++)
+            scaled.set(i, i, 1e-6 * (i + 1));
+        scaled.set(0, n - 1, 5e-7);
+        Matrix product;
+        ASSERT_NO_THROW(product = scaled * scaled.inverse()) << n;
+        for (size_t r = 0; r < n; r++)
+            for (size_t c = 0; c < n; c++)
+                EXPECT_NEAR(product.get(r, c), r == c ? 1.0 : 0.0, 1e-12) << n << "x" << n;
+    }
+    Matrix nearlySingular(3, 3);
+    nearlySingular.set({
+        {1e-6, 2e-6, 3e-6},
+        {2e-6, 4e-6, 6e-6},
+        {1e-6, 0, 1e-6},
+    });
+    EXPECT_THROW(nearlySingular.inverse(), runtime_error);
+
+    // Singular and non square matrices
+    EXPECT_THROW(small.inverse(), runtime_error);
+    EXPECT_THROW(large.inverse(), runtime_error);
+    EXPECT_THROW(Matrix(2, 2).inverse(), runtime_error);
+    EXPECT_THROW(Matrix(7, 7).inverse(), runtime_error);
+}
+
+// Test block(), row() and col() views
+TEST_F(MatrixPreset, views) {
+    // Creating views allocates nothing and writes go to the parent matrix
+    size_t before = MatrixKernels::alignedAllocCount();
+    MatrixView block = large.block(1, 2, 3, 3);
+    ConstMatrixView row = large.row(4);
+    MatrixView col = large.col(5);
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before);
+
+    EXPECT_EQ(block.get(0, 0), 2.2);
+    EXPECT_EQ(block.get(2, 2), -849);
+    EXPECT_EQ(row.get(0, 1), 1000001.10981);
+    EXPECT_EQ(col.rows(), 5u);
+    EXPECT_TRUE(block.set(1, 1, 7));
+    EXPECT_FALSE(block.set(3, 0, 7));
+    EXPECT_EQ(large.get(2, 3), 7);
+    EXPECT_EQ(block.block(1, 1, 2, 2).get(0, 0), 7);
+    EXPECT_THROW(large.block(4, 0, 2, 1), runtime_error);
+    EXPECT_THROW(large.col(6), runtime_error);
+    EXPECT_THROW(block.get(0, 3), runtime_error);
+
+    // Arithmetic, determinant and solve on views against materialized copies
+    Matrix copy(block);
+    EXPECT_TRUE(copy == block);
+    EXPECT_TRUE(block == copy);
+    EXPECT_TRUE(block + block == copy + copy);
+    EXPECT_TRUE(block * 2.0 == copy * 2.0);
+    EXPECT_TRUE(large.block(0, 0, 5, 3) * large.block(0, 3, 3, 3) ==
+                Matrix(large.block(0, 0, 5, 3)) * Matrix(large.block(0, 3, 3, 3)));
+    EXPECT_TRUE(medium.row(1) * medium.col(2) == Matrix(medium.row(1)) * Matrix(medium.col(2)));
+    EXPECT_THROW(block * large.row(0), runtime_error);
+    EXPECT_DOUBLE_EQ(determinant(block), copy.determinant());
+    EXPECT_DOUBLE_EQ(determinant(medium.block(0, 0, 2, 2)), 4 * -55 - 3 * -9.0);
+    EXPECT_THROW(determinant(large.row(0)), runtime_error);
+
+    Matrix big(40, 40);
+    for (size_t r = 0; r < 40; r++)
+        for (size_t c = 0; c < 40; c++)
+            big.set(r, c, r == c ? 40.0 : 1.0 / (1.0 + (r * 7 + c * 3) % 5));
+    ConstMatrixView inner = static_cast<const Matrix &>(big).block(3, 5, 30, 30);
+    Matrix innerCopy(inner);
+    EXPECT_NEAR(determinant(inner), innerCopy.determinant(), 1e-9 * fabs(innerCopy.determinant()));
+    vector<double> b(30, 1.0);
+    vector<double> x = solveEquation(inner, b);
+    vector<double> expected = innerCopy.solveEquation(b);
+    for (size_t i = 0; i < 30; i++)
+        EXPECT_NEAR(x[i], expected[i], 1e-12);
+
+    // Copying a view back into another block
+    big.block(0, 0, 3, 3).assign(medium.block(0, 0, 3, 3));
+    EXPECT_TRUE(big.block(0, 0, 3, 3) == medium);
+}
+
+// Test SparseMatrix
+TEST_F(MatrixPreset, sparseMatrix) {
+    // Conversions keep exactly the non-zero elements
+    SparseMatrix csr(large);
+    SparseMatrix csc(large, SparseMatrix::CSC);
+    EXPECT_EQ(csr.nonZeros(), 27u);
+    EXPECT_EQ(csc.nonZeros(), 27u);
+    EXPECT_TRUE(csr.toDense() == large);
+    EXPECT_TRUE(csc.toDense() == large);
+    EXPECT_TRUE(csr.convert(SparseMatrix::CSC).toDense() == large);
+    EXPECT_TRUE(csc.convert(SparseMatrix::CSR).toDense() == large);
+    EXPECT_EQ(csr.get(1, 5), -999);
+    EXPECT_EQ(csc.get(0, 0), 0);
+    EXPECT_THROW(csr.get(5, 0), runtime_error);
+
+    // Duplicate triplets are summed
+    vector<SparseMatrix::Triplet> triplets = {{1, 2, 1.5}, {0, 0, 2}, {1, 2, 0.5}, {1, 0, -1}};
+    SparseMatrix fromTriplets(2, 3, triplets, SparseMatrix::CSC);
+    EXPECT_EQ(fromTriplets.nonZeros(), 3u);
+    EXPECT_EQ(fromTriplets.get(1, 2), 2);
+    EXPECT_EQ(fromTriplets.get(1, 0), -1);
+    triplets.push_back({2, 0, 1});
+    EXPECT_THROW(SparseMatrix(2, 3, triplets), runtime_error);
+
+    // SpMV and sparse * dense against the dense kernels, big enough to run in parallel
+    const size_t n = 3000;
+    vector<SparseMatrix::Triplet> band;
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = (r < 5 ? 0 : r - 5); c < n && c <= r + 7; c++)
+            band.push_back({r, c, 1.0 / (1.0 + r % 7 + c % 3)});
+    SparseMatrix a(n, n, band);
+    SparseMatrix aCsc = a.convert(SparseMatrix::CSC);
+    ASSERT_GT(a.nonZeros(), 32768u);
+
+    vector<double> x(n);
+    for (size_t i = 0; i < n; i++)
+        x[i] = (i % 11) - 5.0;
+    vector<double> y = a * x;
+    vector<double> yCsc = aCsc * x;
+    for (size_t r = 0; r < n; r += 97) {
+        double expected = 0;
+        for (size_t c = 0; c < n; c++)
+            expected += a.get(r, c) * x[c];
+        EXPECT_NEAR(y[r], expected, 1e-12);
+    }
+    for (size_t r = 0; r < n; r++)
+        EXPECT_NEAR(yCsc[r], y[r], 1e-12);
+    // Second product reuses the cached row-major copy, a copy shares it
+    SparseMatrix cscCopy = aCsc;
+    EXPECT_TRUE(aCsc * x == yCsc);
+    EXPECT_TRUE(cscCopy * x == yCsc);
+    EXPECT_THROW(a * vector<double>(n - 1), runtime_error);
+
+    Matrix dense(n, 20);
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = 0; c < 20; c++)
+            dense.set(r, c, (r * 3 + c) % 13 - 6.0);
+    Matrix product = a * dense;
+    Matrix productCsc = aCsc * dense;
+    Matrix reference = a.toDense() * dense;
+    for (size_t r = 0; r < n; r++) {
+        for (size_t c = 0; c < 20; c++) {
+            EXPECT_NEAR(product.get(r, c), reference.get(r, c), 1e-10);
+            EXPECT_NEAR(productCsc.get(r, c), reference.get(r, c), 1e-10);
+        }
+    }
+    EXPECT_THROW(a * large, runtime_error);
+
+    // Wide dense operand split into column strips
+    SparseMatrix small(a.toDense().block(0, 0, 100, 100), SparseMatrix::CSC);
+    Matrix wide(100, 600);
+    for (size_t r = 0; r < 100; r++)
+        for (size_t c = 0; c < 600; c++)
+            wide.set(r, c, (r * 5 + c) % 17 - 8.0);
+    product = small * wide;
+    reference = small.toDense() * wide;
+    for (size_t r = 0; r < 100; r++)
+        for (size_t c = 0; c < 600; c++)
+            EXPECT_NEAR(product.get(r, c), reference.get(r, c), 1e-10);
+}
+
+// Test conjugateGradient() and gmres()
+TEST_F(MatrixPreset, iterativeSolvers) {
+    // 2D Poisson problem (SPD) and a non symmetric convection-diffusion variant
+    const size_t grid = 30, n = grid * grid;
+    vector<SparseMatrix::Triplet> poisson, convection;
+    for (size_t i = 0; i < grid; i++) {
+        for (size_t j = 0; j < grid; j++) {
+            size_t k = i * grid + j;
+            poisson.push_back({k, k, 4});
+            convection.push_back({k, k, 4});
+            if (j > 0) {
+                poisson.push_back({k, k - 1, -1});
+                convection.push_back({k, k - 1, -1.5});
+            }
+            if (j + 1 < grid) {
+                poisson.push_back({k, k + 1, -1});
+                convection.push_back({k, k + 1, -0.5});
+            }
+            if (i > 0) {
+                poisson.push_back({k, k - grid, -1});
+                convection.push_back({k, k - grid, -1});
+            }
+            if (i + 1 < grid) {
+                poisson.push_back({k, k + grid, -1});
+                convection.push_back({k, k + grid, -1});
+            }
+        }
+    }
+    SparseMatrix spd(n, n, poisson);
+    SparseMatrix general(n, n, convection, SparseMatrix::CSC);
+    vector<double> b(n);
+    for (size_t i = 0; i < n; i++)
+        b[i] = 1.0 + i % 5;
+
+    IterativeSolvers::Options options;
+    IterativeSolvers::Stats stats, preconditioned;
+    options.tolerance = 1e-10;
+
+    vector<double> x = IterativeSolvers::conjugateGradient(spd, b, options, stats);
+    EXPECT_TRUE(stats.converged);
+    EXPECT_LE(stats.residual, 1e-10);
+    vector<double> ax = spd * x;
+    for (size_t i = 0; i < n; i++)
+        EXPECT_NEAR(ax[i], b[i], 1e-7);
+
+    const IterativeSolvers::Preconditioner kinds[] = {IterativeSolvers::PRECOND_JACOBI, IterativeSolvers::PRECOND_ILU0};
+    for (size_t k = 0; k < 2; k++) {
+        options.preconditioner = kinds[k];
+        IterativeSolvers::conjugateGradient(spd, b, options, preconditioned);
+        EXPECT_TRUE(preconditioned.converged);
+        if (kinds[k] == IterativeSolvers::PRECOND_ILU0) {
+            EXPECT_LT(preconditioned.iterations, stats.iterations);
+        }
+
+        x = IterativeSolvers::gmres(general, b, options, preconditioned);
+        EXPECT_TRUE(preconditioned.converged) << k;
+        ax = general * x;
+        for (size_t i = 0; i < n; i++)
+            EXPECT_NEAR(ax[i], b[i], 1e-7);
+    }
+
+    // Dense matrices use the same code through GEMM
+    Matrix dense(general.toDense().block(0, 0, 100, 100));
+    vector<double> small(b.begin(), b.begin() + 100);
+    options.preconditioner = IterativeSolvers::PRECOND_ILU0;
+    options.restart = 10;
+    x = IterativeSolvers::gmres(dense, small, options, stats);
+    EXPECT_TRUE(stats.converged);
+    vector<double> direct = dense.solveEquation(small);
+    for (size_t i = 0; i < 100; i++)
+        EXPECT_NEAR(x[i], direct[i], 1e-8);
+    x = IterativeSolvers::conjugateGradient(Matrix(spd.toDense().block(0, 0, 100, 100)), small, options, stats);
+    EXPECT_TRUE(stats.converged);
+
+    // Iteration limit, bad input
+    options.preconditioner = IterativeSolvers::PRECOND_NONE;
+    options.maxIterations = 3;
+    IterativeSolvers::gmres(general, b, options, stats);
+    EXPECT_FALSE(stats.converged);
+    EXPECT_EQ(stats.iterations, 3u);
+    EXPECT_GT(stats.residual, 1e-10);
+    EXPECT_THROW(IterativeSolvers::conjugateGradient(large, b, options, stats), runtime_error);
+    EXPECT_THROW(IterativeSolvers::gmres(spd, small, options, stats), runtime_error);
+    EXPECT_THROW(IterativeSolvers::conjugateGradient(spd.toDense() * -1.0, b, options, stats), runtime_error);
+
+    // Singular operator breaks down without dividing by zero
+    Matrix zero(10, 10);
+    vector<double> ones(10, 1.0);
+    options.maxIterations = 100;
+    x = IterativeSolvers::gmres(zero, ones, options, stats);
+    EXPECT_FALSE(stats.converged);
+    EXPECT_EQ(stats.iterations, 1u);
+    for (size_t i = 0; i < 10; i++)
+        EXPECT_EQ(x[i], 0.0);
+
+    // Singular, inconsistent systems: breakdown is detected at rounding level, the iterate stays bounded
+    const double singular[2][9] = {{1, 0, 1, 0, 2, 2, 0, 0, 0}, {1, 0, 0, 0, 1, 0, 0, 0, 0}};
+    options.maxIterations = 1000;
+    for (size_t s = 0; s < 2; s++) {
+        Matrix a(3, 3);
+        for (size_t i = 0; i < 9; i++)
+            a.set(i / 3, i % 3, singular[s][i]);
+        x = IterativeSolvers::gmres(a, vector<double>(3, 1.0), options, stats);
+        EXPECT_FALSE(stats.converged);
+        EXPECT_LE(stats.iterations, 3u);
+        EXPECT_NEAR(stats.residual, 1 / sqrt(3.0), 1e-12);
+        for (size_t i = 0; i < 3; i++)
+            EXPECT_LT(fabs(x[i]), 10.0) << s;
+    }
+}
+
+// Test Factorization
+TEST_F(MatrixPreset, factorization) {
+    const size_t n = 120, nrhs = 70;
+    Matrix a(n, n), b(n, nrhs);
+    for (size_t r = 0; r < n; r++) {
+        for (size_t c = 0; c < n; c++)
+            a.set(r, c, r == c ? n + 1.0 : 1.0 / (1.0 + (r * 7 + c * 3) % 5) - (r % 3 == 0 ? 0.5 : 0.0));
+        for (size_t c = 0; c < nrhs; c++)
+            b.set(r, c, (r * 5 + c) % 9 - 4.0);
+    }
+
+    Factorization lu(a);
+    EXPECT_EQ(lu.method(), SOLVE_LU);
+    EXPECT_EQ(lu.size(), n);
+    EXPECT_NEAR(lu.determinant(), a.determinant(), 1e-9 * fabs(a.determinant()));
+
+    // Single right hand sides match solveEquation, batches match A^-1 B
+    vector<double> column(n);
+    for (size_t r = 0; r < n; r++)
+        column[r] = b.get(r, 3);
+    vector<double> x = lu.solve(column);
+    vector<double> expected = a.solveEquation(column);
+    for (size_t r = 0; r < n; r++)
+        EXPECT_NEAR(x[r], expected[r], 1e-12);
+
+    Matrix xs = lu.solve(b);
+    Matrix residual = a * xs;
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = 0; c < nrhs; c++)
+            EXPECT_NEAR(residual.get(r, c), b.get(r, c), 1e-10);
+
+    lu.solveInPlace(b.block(0, 10, n, 5));
+    for (size_t r = 0; r < n; r++)
+        EXPECT_NEAR(b.get(r, 12), xs.get(r, 12), 1e-12);
+
+    EXPECT_THROW(lu.solve(vector<double>(n + 1)), runtime_error);
+    EXPECT_THROW(lu.solve(large), runtime_error);
+    EXPECT_THROW(Factorization{large}, runtime_error);
+    EXPECT_THROW(Factorization{Matrix(4, 4)}, runtime_error);
+}
+
+// Test cholesky() and solveEquation() with SOLVE_CHOLESKY / SOLVE_AUTO
+TEST_F(MatrixPreset, cholesky) {
+    // SPD matrix A = M M^T + n I of an order crossing several blocks
+    const size_t n = 150;
+    Matrix m(n, n);
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = 0; c < n; c++)
+            m.set(r, c, (r * 13 + c * 7) % 11 / 10.0 - 0.5);
+    Matrix a = m * m.transpose();
+    for (size_t i = 0; i < n; i++)
+        a.set(i, i, a.get(i, i) + n);
+
+    Matrix l = a.cholesky();
+    EXPECT_EQ(l.get(0, 1), 0);
+    Matrix product = l * l.transpose();
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = 0; c < n; c++)
+            EXPECT_NEAR(product.get(r, c), a.get(r, c), 1e-10);
+
+    vector<double> b(n);
+    for (size_t i = 0; i < n; i++)
+        b[i] = i % 7 - 3.0;
+    vector<double> expected = a.solveEquation(b);
+    vector<double> x = a.solveEquation(b, SOLVE_CHOLESKY);
+    vector<double> automatic = a.solveEquation(b, SOLVE_AUTO);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(x[i], expected[i], 1e-12);
+        EXPECT_NEAR(automatic[i], expected[i], 1e-12);
+    }
+
+    // Factorization reuses L for batches, AUTO falls back to LU
+    Factorization spd(a, SOLVE_AUTO);
+    EXPECT_EQ(spd.method(), SOLVE_CHOLESKY);
+    ConstMatrixView leading = a.block(0, 0, 10, 10);
+    EXPECT_NEAR(Factorization(leading, SOLVE_CHOLESKY).determinant() / determinant(leading), 1.0, 1e-12);
+    Matrix rhs = m * 2.0;
+    Matrix xs = spd.solve(rhs);
+    Matrix residual = a * xs;
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = 0; c < n; c++)
+            EXPECT_NEAR(residual.get(r, c), rhs.get(r, c), 1e-10);
+
+    Matrix nonSymmetric = a;
+    nonSymmetric.set(0, 1, a.get(0, 1) + 1);
+    EXPECT_EQ(Factorization(nonSymmetric, SOLVE_AUTO).method(), SOLVE_LU);
+    Matrix indefinite = a * -1.0;
+    EXPECT_EQ(Factorization(indefinite, SOLVE_AUTO).method(), SOLVE_LU);
+    x = indefinite.solveEquation(b, SOLVE_AUTO);
+    for (size_t i = 0; i < n; i++)
+        EXPECT_NEAR(x[i], -expected[i], 1e-12);
+
+    EXPECT_THROW(indefinite.cholesky(), runtime_error);
+    EXPECT_THROW(indefinite.solveEquation(b, SOLVE_CHOLESKY), runtime_error);
+    EXPECT_THROW(large.cholesky(), runtime_error);
+    EXPECT_THROW(medium.solveEquation(b, SOLVE_AUTO), runtime_error);
+}
+
+// Test leastSquares() and QR factorization
+TEST_F(MatrixPreset, leastSquares) {
+    // Square systems give the same solution as LU
+    vector<double> b = {1, -2, 3};
+    vector<double> expected = medium.solveEquation(b);
+    vector<double> x = medium.solveEquation(b, SOLVE_QR);
+    for (size_t i = 0; i < 3; i++)
+        EXPECT_NEAR(x[i], expected[i], 1e-12);
+    EXPECT_NEAR(Factorization(medium, SOLVE_QR).determinant(), medium.determinant(), 1e-9);
+
+    // Overdetermined regression: exact data plus a residual orthogonal to the columns
+    // (serial path and the threaded TSQR path)
+    const size_t rowsList[] = {50, 40000};
+    const size_t n = 7;
+    for (size_t s = 0; s < 2; s++) {
+        const size_t m = rowsList[s];
+        Matrix a(m, n);
+        vector<double> coef(n), rhs(m, 0.0);
+        for (size_t c = 0; c < n; c++)
+            coef[c] = c + 1.0;
+        for (size_t r = 0; r < m; r++) {
+            double t = double(r) / m;
+            double p = 1;
+            for (size_t c = 0; c < n; c++, p *= t) {
+                a.set(r, c, p + (r * 7 + c * 3) % 5 * 1e-3);
+                rhs[r] += coef[c] * a.get(r, c);
+            }
+        }
+
+        x = a.leastSquares(rhs);
+        ASSERT_EQ(x.size(), n);
+        for (size_t c = 0; c < n; c++)
+            EXPECT_NEAR(x[c], coef[c], 1e-6) << m;
+
+        // Perturbing b by a vector orthogonal to range(A) must not change x
+        Factorization qr(a, SOLVE_QR);
+        EXPECT_EQ(qr.method(), SOLVE_QR);
+        EXPECT_EQ(qr.unknowns(), n);
+        vector<double> noise(m);
+        for (size_t r = 0; r < m; r++)
+            noise[r] = (r % 3) - 1.0;
+        vector<double> projected = qr.solve(noise);
+        vector<double> fitted(m, 0.0);
+        for (size_t r = 0; r < m; r++)
+            for (size_t c = 0; c < n; c++)
+                fitted[r] += a.get(r, c) * projected[c];
+        for (size_t r = 0; r < m; r++)
+            rhs[r] += noise[r] - fitted[r];
+        x = a.leastSquares(rhs);
+        for (size_t c = 0; c < n; c++)
+            EXPECT_NEAR(x[c], coef[c], 1e-6) << m;
+
+        // TSQR with an explicit pool regardless of the machine's core count
+        ThreadPool pool(4);
+        Matrix copy = a;
+        vector<double> tsqr = rhs;
+        ASSERT_TRUE(MatrixKernels::gels(&pool, m, n, copy.data(), copy.stride(), tsqr.data(), 0.0));
+        for (size_t c = 0; c < n; c++)
+            EXPECT_NEAR(tsqr[c], coef[c], 1e-6) << m;
+
+        // Batch of right hand sides
+        Matrix batch(m, 2);
+        for (size_t r = 0; r < m; r++) {
+            batch.set(r, 0, rhs[r]);
+            batch.set(r, 1, 2 * rhs[r]);
+        }
+        Matrix xs = qr.solve(batch);
+        ASSERT_EQ(xs.rows(), n);
+        for (size_t c = 0; c < n; c++) {
+            EXPECT_NEAR(xs.get(c, 0), coef[c], 1e-6);
+            EXPECT_NEAR(xs.get(c, 1), 2 * coef[c], 1e-6);
+        }
+    }
+
+    // Several reflector blocks, the second and third use the stored T factors
+    const size_t blocks = 2 * MatrixKernels::QR_NB + 5;
+    Matrix tall(blocks + 40, blocks);
+    vector<double> known(blocks), image(blocks + 40, 0.0);
+    for (size_t c = 0; c < blocks; c++)
+        known[c] = (c % 9) - 4.0;
+    for (size_t r = 0; r < tall.rows(); r++) {
+        for (size_t c = 0; c < blocks; c++) {
+            tall.set(r, c, (r == c ? 10.0 : 0.0) + ((r * 13 + c * 7) % 11) * 0.1);
+            image[r] += tall.get(r, c) * known[c];
+        }
+    }
+    x = Factorization(tall, SOLVE_QR).solve(image);
+    for (size_t c = 0; c < blocks; c++)
+        EXPECT_NEAR(x[c], known[c], 1e-9);
+    x = tall.leastSquares(image);
+    for (size_t c = 0; c < blocks; c++)
+        EXPECT_NEAR(x[c], known[c], 1e-9);
+
+    // Wide or rank deficient matrices
+    EXPECT_THROW(Matrix(2, 3).leastSquares(vector<double>(2)), runtime_error);
+    EXPECT_THROW(Matrix(5, 2).leastSquares(vector<double>(5)), runtime_error);
+    EXPECT_THROW(Factorization(Matrix(5, 2), SOLVE_QR), runtime_error);
+    EXPECT_THROW(large.leastSquares(vector<double>(5)), runtime_error);
+}
+
+// Test multiply() with MULTIPLY_STRASSEN
+TEST(MatrixKernels, strassen) {
+    // Odd sizes just above the leaf size exercise one recursion level and peeling
+    const size_t m = MatrixKernels::STRASSEN_LEAF + 3;
+    const size_t n = MatrixKernels::STRASSEN_LEAF + 5;
+    const size_t k = MatrixKernels::STRASSEN_LEAF + 1;
+    Matrix a(m, k), b(k, n);
+    for (size_t r = 0; r < m; r++)
+        for (size_t c = 0; c < k; c++)
+            a.set(r, c, ((r * 7 + c * 13) % 17) / 8.0 - 1.0);
+    for (size_t r = 0; r < k; r++)
+        for (size_t c = 0; c < n; c++)
+            b.set(r, c, ((r * 5 + c * 3) % 11) / 5.0 - 1.0);
+
+    Matrix classic = a * b;
+    Matrix strassen(m, n);
+    MatrixKernels::gemmStrassen(nullptr, m, n, k, a.data(), a.stride(), b.data(), b.stride(),
+                                strassen.data(), strassen.stride(), MatrixKernels::STRASSEN_LEAF);
+    for (size_t r = 0; r < m; r++)
+        for (size_t c = 0; c < n; c++)
+            ASSERT_NEAR(strassen.get(r, c), classic.get(r, c), 1e-9) << r << ", " << c;
+
+    // Below the threshold the policy falls back to the classic kernel
+    EXPECT_TRUE(multiply(a, b, MULTIPLY_STRASSEN) == classic);
+    Matrix small(a.block(0, 0, 10, 10));
+    EXPECT_TRUE(multiply(small, small, MULTIPLY_STRASSEN) == small * small);
+    EXPECT_TRUE(multiply(small, small, MULTIPLY_CLASSIC) == small * small);
+    EXPECT_THROW(multiply(a, a, MULTIPLY_STRASSEN), runtime_error);
+}
+
+TEST(MatrixKernels, mixedPrecision) {
+    const size_t n = 150;
+    Matrix a(n, n);
+    std::vector<double> x(n), b(n, 0.0);
+    for (size_t r = 0; r < n; r++) {
+        x[r] = 1.0 + r / 7.0;
+        for (size_t c = 0; c < n; c++)
+            a.set(r, c, (r == c ? n : 0.0) + ((r * 7 + c * 13) % 17) / 8.0 - 1.0);
+    }
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = 0; c < n; c++)
+            b[r] += a.get(r, c) * x[c];
+
+    // Float storage keeps the aligned row layout, products agree to float precision
+    MatrixF low(a);
+    EXPECT_EQ(low.stride() * sizeof(float) % MATRIX_ALIGN_BYTES, 0u);
+    EXPECT_FLOAT_EQ(low.get(3, 5), static_cast<float>(a.get(3, 5)));
+    Matrix product(low * low), exact = a * a;
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = 0; c < n; c++)
+            ASSERT_NEAR(product.get(r, c), exact.get(r, c), 1e-5 * n * n) << r << ", " << c;
+    EXPECT_TRUE(Matrix(MatrixF(Matrix(low))) == Matrix(low));
+
+    // Element-wise operations and views run on the float kernels
+    MatrixF sum = low + low;
+    MatrixF twice = low * 2.0f;
+    EXPECT_TRUE(sum == twice);
+    EXPECT_FALSE(sum == low);
+    MatrixF acc(low);
+    acc += low;
+    EXPECT_TRUE(acc == twice);
+    acc.axpy(-2.0f, low);
+    EXPECT_TRUE(acc == MatrixF(n, n));
+    MatrixF corner(low.block(1, 2, 3, 4));
+    EXPECT_EQ(corner.rows(), 3u);
+    EXPECT_EQ(corner.get(2, 3), low.get(3, 5));
+    EXPECT_TRUE(corner == low.block(1, 2, 3, 4));
+    low.row(0).set(0, 0, 0.5f);
+    EXPECT_EQ(low.get(0, 0), 0.5f);
+    EXPECT_EQ(low.col(5).get(3, 0), low.get(3, 5));
+    MatrixF blockProduct = MatrixF(low.block(0, 0, 3, n)) * low.block(0, 0, n, 2);
+    EXPECT_NEAR(blockProduct.get(2, 1), (low * low).get(2, 1), 1e-3);
+    EXPECT_THROW(low + corner, runtime_error);
+    EXPECT_THROW(low == corner, runtime_error);
+
+    // Refinement in double recovers full double accuracy from the float factors
+    std::vector<double> refined(b);
+    size_t steps = MatrixKernels::gesvMixed(n, a.data(), a.stride(), refined.data());
+    EXPECT_GE(steps, 2u);
+    EXPECT_LE(steps, MatrixKernels::MIXED_MAX_ITERATIONS);
+    std::vector<double> mixed = a.solveEquation(b, SOLVE_MIXED);
+    for (size_t r = 0; r < n; r++) {
+        EXPECT_NEAR(refined[r], x[r], 1e-12 * x[r]);
+        EXPECT_EQ(mixed[r], refined[r]);
+    }
+
+    // Singular in float (Hilbert matrix) or out of float range: b stays, solve falls back to double LU
+    Matrix hilbert(12, 12);
+    for (size_t r = 0; r < 12; r++)
+        for (size_t c = 0; c < 12; c++)
+            hilbert.set(r, c, 1.0 / (r + c + 1));
+    std::vector<double> ones(12, 1.0), untouched(ones);
+    EXPECT_EQ(MatrixKernels::gesvMixed(12, hilbert.data(), hilbert.stride(), untouched.data()), 0u);
+    EXPECT_EQ(untouched, ones);
+    EXPECT_EQ(hilbert.solveEquation(ones, SOLVE_MIXED), hilbert.solveEquation(ones, SOLVE_LU));
+    Matrix huge(a * 1e300);
+    EXPECT_EQ(MatrixKernels::gesvMixed(n, huge.data(), huge.stride(), refined.data()), 0u);
+    EXPECT_THROW(MatrixF(0, 1), runtime_error);
+    EXPECT_THROW(low.get(n, 0), runtime_error);
+}
+
+TEST(MatrixBatch, smallMatrices) {
+    // Count not divisible by the lane width leaves a partially filled last block
+    const size_t count = 203;
+    for (size_t n = 1; n <= 4; n++) {
+        MatrixBatch a(n, n, count), b(n, 1, count);
+        std::vector<double> rhs(n);
+        for (size_t r = 0; r < n; r++)
+            rhs[r] = r + 1.0;
+        for (size_t i = 0; i < count; i++)
+            for (size_t r = 0; r < n; r++) {
+                b.set(i, r, 0, rhs[r]);
+                for (size_t c = 0; c < n; c++)
+                    a.set(i, r, c, ((i * 7 + r * 5 + c * 3) % 11) / 4.0 - 1.0 + (r == c ? 2.0 : 0.0));
+            }
+
+        std::vector<double> det = a.determinant();
+        MatrixBatch inv = a.inverse();
+        MatrixBatch x = a.solveEquation(b);
+        ASSERT_EQ(det.size(), count);
+        for (size_t i = 0; i < count; i++) {
+            Matrix m = a.matrix(i);
+            EXPECT_NEAR(det[i], m.determinant(), 1e-12 * (1 + std::fabs(det[i]))) << n << ", " << i;
+            std::vector<double> solution = m.solveEquation(rhs);
+            Matrix product = m * inv.matrix(i);
+            for (size_t r = 0; r < n; r++) {
+                EXPECT_NEAR(x.get(i, r, 0), solution[r], 1e-10);
+                for (size_t c = 0; c < n; c++)
+                    EXPECT_NEAR(product.get(r, c), r == c ? 1.0 : 0.0, 1e-12);
+            }
+        }
+    }
+}
+
+TEST(MatrixBatch, parallelAndErrors) {
+    // Large batches are split between threads, a singular matrix has zero determinant
+    ThreadPool pool(4);
+    const size_t count = 20001;
+    MatrixBatch a(3, 3, count), b(3, 1, count);
+    for (size_t i = 0; i < count; i++)
+        for (size_t r = 0; r < 3; r++) {
+            b.set(i, r, 0, 1.0);
+            for (size_t c = 0; c < 3; c++)
+                a.set(i, r, c, r == c ? i + 2.0 : 1.0);
+        }
+    std::vector<double> det = a.determinant(&pool);
+    MatrixBatch x = a.solveEquation(b, &pool);
+    for (size_t i = 0; i < count; i += 997) {
+        double d = i + 2.0;
+        EXPECT_NEAR(det[i], (d - 1) * (d - 1) * (d + 2), 1e-12 * det[i]);
+        EXPECT_NEAR(x.get(i, 2, 0), 1 / (d + 2), 1e-14);
+    }
+    for (size_t c = 0; c < 3; c++)
+        a.set(count - 1, c, c, 1.0);
+    EXPECT_EQ(a.determinant(&pool)[count - 1], 0.0);
+    EXPECT_THROW(a.inverse(&pool), runtime_error);
+    EXPECT_THROW(a.solveEquation(b, &pool), runtime_error);
+
+    Matrix m(2, 2);
+    MatrixBatch copy(a);
+    EXPECT_FALSE(copy.set(0, m));
+    EXPECT_FALSE(copy.set(count, 0, 0, 1.0));
+    EXPECT_THROW(copy.get(count, 0, 0), runtime_error);
+    EXPECT_THROW(MatrixBatch(2, 3, 4).determinant(), runtime_error);
+    EXPECT_THROW(MatrixBatch(5, 5, 4).inverse(), runtime_error);
+    EXPECT_THROW(a.solveEquation(MatrixBatch(3, 1, 4)), runtime_error);
+    EXPECT_TRUE(copy.set(1, a.matrix(2)));
+    EXPECT_TRUE(copy.matrix(1) == a.matrix(2));
+}
+
+// Test binary matrix files and their memory mapping
+TEST_F(MatrixPreset, matrixFile) {
+    const std::string path = "white_box_test_matrix.bin";
+
+    // Views are written with their own stride, rows in the file are aligned
+    writeMatrixFile(path, large.block(1, 1, 4, 5));
+    MatrixFileHeader header = readMatrixFileHeader(path);
+    EXPECT_EQ(header.rows, 4u);
+    EXPECT_EQ(header.cols, 5u);
+    EXPECT_EQ(header.stride % MATRIX_ALIGN_ELEMS, 0u);
+    EXPECT_EQ(header.dtype, (uint32_t) MATRIX_FILE_F64);
+
+    // Mapping does not copy the data, the view reads the file directly
+    size_t before = MatrixKernels::alignedAllocCount();
+    MappedMatrixFile file(path);
+    ConstMatrixView view = file.view<double>();
+    EXPECT_EQ(MatrixKernels::alignedAllocCount(), before);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(view.data()) % MATRIX_ALIGN_BYTES, 0u);
+    EXPECT_TRUE(view == large.block(1, 1, 4, 5));
+    for (size_t r = 0; r < view.rows(); r++)
+        EXPECT_EQ(view.data()[r * view.stride() + view.cols()], 0);
+    EXPECT_TRUE(Matrix(view) * 2.0 == view + view);
+    EXPECT_THROW(file.view<float>(), runtime_error);
+
+    MappedMatrixFile moved(std::move(file));
+    EXPECT_TRUE(moved.view<double>() == large.block(1, 1, 4, 5));
+
+    // Single precision matrices keep their type
+    MatrixF single(medium);
+    writeMatrixFile(path, single);
+    MappedMatrixFile singleFile(path);
+    EXPECT_EQ(singleFile.dtype(), MATRIX_FILE_F32);
+    EXPECT_EQ(singleFile.view<float>().get(2, 1), 19.0f);
+    EXPECT_THROW(singleFile.view<double>(), runtime_error);
+
+    // Damaged files are rejected
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write("truncated", 8);
+    }
+    EXPECT_THROW(MappedMatrixFile mapped(path), runtime_error);
+    EXPECT_THROW(readMatrixFileHeader(path), runtime_error);
+    header.magic[0] = 'X';
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(std::string(4 * header.stride * sizeof(double), '\0').data(), 4 * header.stride * sizeof(double));
+    }
+    EXPECT_THROW(MappedMatrixFile mapped(path), runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(MappedMatrixFile mapped(path), runtime_error);
+    EXPECT_THROW(readMatrixFileHeader(path), runtime_error);
+}
+
+// Test out-of-core multiplication of matrix files
+TEST(OutOfCore, multiply) {
+    const size_t m = 37, k = 50, n = 29;
+    Matrix a(m, k), b(k, n);
+    for (size_t r = 0; r < m; r++)
+        for (size_t c = 0; c < k; c++)
+            a.set(r, c, (double) ((r * 5 + c * 3) % 11) - 5);
+    for (size_t r = 0; r < k; r++)
+        for (size_t c = 0; c < n; c++)
+            b.set(r, c, (double) ((r + c * 7) % 9) - 4);
+    writeMatrixFile("white_box_ooc_a.bin", a);
+    writeMatrixFile("white_box_ooc_b.bin", b);
+
+    // Ragged tiles in every dimension, integer data makes every order exact
+    ThreadPool pool(4);
+    OutOfCore::Options options;
+    OutOfCore::Stats stats;
+    options.maxTile = 16;
+    options.pool = &pool;
+    OutOfCore::multiply("white_box_ooc_a.bin", "white_box_ooc_b.bin", "white_box_ooc_c.bin", options, stats);
+    EXPECT_EQ(stats.tile, 16u);
+    EXPECT_EQ(stats.tilesRead, 2u * 3 * 2 * 4);
+    {
+        MappedMatrixFile c("white_box_ooc_c.bin");
+        EXPECT_TRUE(c.view<double>() == a * b);
+    }
+
+    // Tile size follows the memory budget
+    ThreadPool serial(1);
+    options.maxTile = 0;
+    options.pool = &serial;
+    options.memoryBudget = 48 * 1024;
+    OutOfCore::multiply("white_box_ooc_a.bin", "white_box_ooc_b.bin", "white_box_ooc_c.bin", options, stats);
+    EXPECT_LE(stats.peakBytes, options.memoryBudget);
+    EXPECT_LT(stats.tile, k);
+    {
+        MappedMatrixFile c("white_box_ooc_c.bin");
+        EXPECT_TRUE(c.view<double>() == a * b);
+    }
+
+    options.memoryBudget = 1024;
+    EXPECT_THROW(OutOfCore::multiply("white_box_ooc_a.bin", "white_box_ooc_b.bin", "white_box_ooc_c.bin", options, stats), runtime_error);
+    options.memoryBudget = size_t(1) << 30;
+    EXPECT_THROW(OutOfCore::multiply("white_box_ooc_a.bin", "white_box_ooc_a.bin", "white_box_ooc_c.bin", options, stats), runtime_error);
+    EXPECT_THROW(OutOfCore::multiply("white_box_ooc_a.bin", "white_box_ooc_b.bin", "white_box_ooc_a.bin", options, stats), runtime_error);
+    EXPECT_THROW(OutOfCore::multiply("white_box_ooc_a.bin", "white_box_ooc_missing.bin", "white_box_ooc_c.bin", options, stats), runtime_error);
+
+    std::remove("white_box_ooc_a.bin");
+    std::remove("white_box_ooc_b.bin");
+    std::remove("white_box_ooc_c.bin");
+}
+
+TEST(TaskGraph, dependencies) {
+    ThreadPool pool(4);
+
+    // Diamond chains: each task records its finishing order, every task
+    // must finish after all of its prerequisites
+    TaskGraph graph;
+    vector<size_t> order(40);
+    atomic<size_t> counter(0);
+    for (size_t i = 0; i < order.size(); i++) {
+        TaskGraph::TaskId id = graph.add("T" + to_string(i), [&, i]() { order[i] = counter++; });
+        EXPECT_EQ(id, i);
+        if (i >= 1)
+            graph.depend(i, (i - 1) / 2 * 2);
+        if (i >= 3 && i % 2 == 1)
+            graph.depend(i, i - 2);
+    }
+    EXPECT_EQ(graph.size(), order.size());
+    EXPECT_THROW(graph.depend(3, 3), runtime_error);
+    EXPECT_THROW(graph.depend(2, 7), runtime_error);
+
+    TaskTrace trace;
+    graph.run(pool, &trace);
+    EXPECT_EQ(counter, order.size());
+    for (size_t i = 1; i < order.size(); i++) {
+        EXPECT_GT(order[i], order[(i - 1) / 2 * 2]);
+        if (i >= 3 && i % 2 == 1) {
+            EXPECT_GT(order[i], order[i - 2]);
+        }
+    }
+
+    // Trace holds every task exactly once, sorted by start time
+    EXPECT_EQ(trace.workers, 4u);
+    ASSERT_EQ(trace.events.size(), order.size());
+    for (size_t i = 0; i < trace.events.size(); i++) {
+        EXPECT_LE(trace.events[i].start, trace.events[i].end);
+        EXPECT_LE(trace.events[i].end, trace.makespan);
+        EXPECT_LT(trace.events[i].worker, 4u);
+        if (i > 0) {
+            EXPECT_LE(trace.events[i - 1].start, trace.events[i].start);
+        }
+    }
+    EXPECT_GE(trace.utilization(), 0.0);
+    EXPECT_LE(trace.utilization(), 1.0);
+    ostringstream chrome, text;
+    trace.writeChromeTrace(chrome);
+    trace.writeText(text);
+    EXPECT_NE(chrome.str().find("\"name\":\"T0\""), string::npos);
+    string lines = text.str();
+    EXPECT_EQ((size_t) count(lines.begin(), lines.end(), '\n'), order.size());
+
+    // The graph can run again, a failing task stops the rest
+    graph.run(pool);
+    EXPECT_EQ(counter, 2 * order.size());
+    TaskGraph failing;
+    atomic<int> after(0);
+    failing.add("fail", []() { throw runtime_error("task failed"); });
+    failing.add("after", [&]() { after++; });
+    failing.depend(1, 0);
+    EXPECT_THROW(failing.run(pool), runtime_error);
+    EXPECT_EQ(after, 0);
+
+    TaskGraph empty;
+    empty.run(pool);
+}
+
+// Test tiled LU and Cholesky against the fork-join kernels
+TEST(TiledFactorization, luAndCholesky) {
+    // Ragged tiles: 100 = 6 * 16 + 4
+    const size_t n = 100;
+    Matrix a(n, n);
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = 0; c < n; c++)
+            a.set(r, c, (double) ((r * 37 + c * 11) % 23) / 7.0 - 1.5 + (r == c ? 0.25 : 0.0));
+
+    ThreadPool pool(4);
+    TaskTrace trace;
+    TiledFactorization::Options options;
+    options.tile = 16;
+    options.pool = &pool;
+    options.trace = &trace;
+
+    Matrix lu = a, reference = a;
+    vector<size_t> pivots(n), referencePivots(n);
+    ASSERT_TRUE(MatrixKernels::getrf(n, reference.data(), reference.stride(), referencePivots.data(), 1e-12));
+    ASSERT_TRUE(TiledFactorization::getrf(lu, pivots.data(), 1e-12, options));
+    EXPECT_EQ(pivots, referencePivots);
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = 0; c < n; c++)
+            EXPECT_NEAR(lu.get(r, c), reference.get(r, c), 1e-10);
+
+    // 7 panels, sum of TRSM and GEMM over the steps, 6 final row swaps
+    size_t tasks = 7 + 6;
+    for (size_t k = 0; k < 7; k++)
+        tasks += (6 - k) + (6 - k) * (6 - k);
+    EXPECT_EQ(trace.events.size(), tasks);
+    EXPECT_EQ(trace.workers, 4u);
+
+    vector<double> b(n), x(n);
+    for (size_t i = 0; i < n; i++)
+        b[i] = x[i] = i % 5 - 2.0;
+    MatrixKernels::getrs(n, lu.data(), lu.stride(), pivots.data(), x.data());
+    vector<double> residual = a * x;
+    for (size_t i = 0; i < n; i++)
+        EXPECT_NEAR(residual[i], b[i], 1e-10);
+
+    // SPD matrix A A^T + n I, only the lower triangle is compared
+    Matrix spd = a * a.transpose();
+    for (size_t i = 0; i < n; i++)
+        spd.set(i, i, spd.get(i, i) + n);
+    Matrix l = spd;
+    reference = spd;
+    ASSERT_TRUE(MatrixKernels::potrf(n, reference.data(), reference.stride()));
+    ASSERT_TRUE(TiledFactorization::potrf(l, options));
+    for (size_t r = 0; r < n; r++)
+        for (size_t c = 0; c <= r; c++)
+            EXPECT_NEAR(l.get(r, c), reference.get(r, c), 1e-10);
+    EXPECT_EQ(trace.events.front().name, "POTRF(0)");
+
+    // Single tile and single thread
+    ThreadPool serial(1);
+    options.tile = TiledFactorization::DEFAULT_TILE;
+    options.pool = &serial;
+    l = spd;
+    ASSERT_TRUE(TiledFactorization::potrf(l, options));
+    EXPECT_EQ(trace.events.size(), 1u);
+    EXPECT_NEAR(l.get(n - 1, 0), reference.get(n - 1, 0), 1e-10);
+
+    // Failures
+    options.tile = 16;
+    options.pool = &pool;
+    Matrix indefinite = spd * -1.0;
+    EXPECT_FALSE(TiledFactorization::potrf(indefinite, options));
+    Matrix singular = a;
+    for (size_t c = 0; c < n; c++)
+        singular.set(60, c, 2 * singular.get(3, c));
+    EXPECT_FALSE(TiledFactorization::getrf(singular, pivots.data(), 1e-12, options));
+    Matrix rectangular(n, n - 1);
+    EXPECT_THROW(TiledFactorization::potrf(rectangular, options), runtime_error);
+    EXPECT_THROW(TiledFactorization::getrf(rectangular, pivots.data(), 1e-12, options), runtime_error);
 }
 
 /*** Konec souboru white_box_tests.cpp ***/